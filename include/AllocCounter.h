@@ -0,0 +1,22 @@
+#pragma once
+
+#include <Arduino.h>
+
+/*
+Heap allocation counter for one task:
+ - every malloc/calloc/realloc made by the watched task bumps count() (other tasks are ignored)
+ - the allocator is wrapped at link time (-Wl,--wrap in platformio.ini), the sim String allocates like WString
+ - loop() reads it around each frame, the draw path is expected to add nothing
+*/
+class AllocCounter {
+public:
+  static void watch(TaskHandle_t task) { watched = task; }
+  static uint32_t count() { return allocations; }
+  static void record() {
+    if (watched != NULL && xTaskGetCurrentTaskHandle() == watched) allocations++;
+  }
+
+private:
+  static TaskHandle_t watched;
+  static volatile uint32_t allocations;
+};
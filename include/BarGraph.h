@@ -0,0 +1,34 @@
+#pragma once
+
+#include <TFT_eSPI.h>
+#include "Layout.h"
+#include "GreySprite.h"
+
+/*
+Bar chart widget for the temperature history:
+ - begin() pre-renders one column strip: a full column of background over a full column of blocks
+ - each bar is a single blit of a column-high window of that strip, so blocks and the
+   background above them are painted in one copy (no per-block fillRect, no clearing pass)
+ - draw() remembers the bars it painted, changed() tells whether a repaint is needed
+*/
+class BarGraph {
+public:
+  static const uint8_t maxColumns = 32;
+
+  explicit BarGraph(TFT_eSPI* tft) : strip(tft) {}
+
+  bool begin(const GraphGeometry& geometry, uint8_t columns, uint8_t levels, uint16_t colour, uint16_t background);
+  bool changed(const uint8_t* bars) const;
+  void draw(GreySprite& target, const uint8_t* bars);
+  void invalidate() { drawn = false; } // target was cleared, repaint on the next draw
+
+private:
+  GreySprite strip;
+  GraphGeometry geometry;
+  uint8_t columns = 0;
+  uint8_t levels = 0;
+  int16_t columnHeight = 0;
+
+  uint8_t drawnBars[maxColumns];
+  bool drawn = false;
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+/*
+Boot phase timestamps (millis() since power-on):
+ - mark() records when a phase completed, the first mark wins so retries don't move it
+ - phases complete in any order (NTP runs alongside geocoding and the weather fetch)
+ - report() prints one line per phase once complete() is true, for tracking startup latency
+*/
+class BootTimeline {
+public:
+  enum Phase : uint8_t {
+    FIRST_FRAME, // dashboard (cached or placeholders) on the panel
+    WIFI,        // station connected
+    TIME,        // NTP synchronised
+    LOCATION,    // coordinates known (NVS or geocoding)
+    WEATHER,     // first live weather reading
+    PHASE_COUNT
+  };
+
+  void mark(Phase phase, unsigned long now);
+  bool done(Phase phase) const { return (doneMask.load() >> phase) & 1; }
+  unsigned long at(Phase phase) const { return times[phase]; }
+  bool complete() const { return doneMask.load() == (1u << PHASE_COUNT) - 1; }
+
+  void report(Print& out) const;
+
+private:
+  std::atomic<uint8_t> doneMask{0}; // marked from both cores, fetch_or so concurrent marks don't drop a bit
+  unsigned long times[PHASE_COUNT] = {};
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Screen rectangle in sprite coordinates
+struct Rect {
+  int16_t x;
+  int16_t y;
+  int16_t w;
+  int16_t h;
+};
+
+/*
+Dirty rectangle list for partial sprite pushes:
+ - add() merges touching/overlapping rectangles, and folds the cheapest pair when the list is full
+ - take() hands the dirty windows to the sender (FramePush) and clears the list
+ - once the dirty area passes fullPushPercent of the sprite a single full push is used instead
+*/
+class DirtyRegions {
+public:
+  static const uint8_t maxRects = 12;
+  static const uint8_t fullPushPercent = 60;
+
+  DirtyRegions(int16_t width, int16_t height) : width(width), height(height) {}
+
+  void add(int16_t x, int16_t y, int16_t w, int16_t h);
+  void add(const Rect& r) { add(r.x, r.y, r.w, r.h); }
+  void markAll() { count = 1; rects[0] = { 0, 0, width, height }; }
+  bool isEmpty() const { return count == 0; }
+  uint32_t area() const;
+
+  // Copy the windows to send into out[maxRects] and clear the list, returns how many
+  uint8_t take(Rect* out);
+
+private:
+  static bool touches(const Rect& a, const Rect& b);
+  static Rect merged(const Rect& a, const Rect& b);
+  void mergeCheapestPair();
+
+  int16_t width;
+  int16_t height;
+  Rect rects[maxRects];
+  uint8_t count = 0;
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <TFT_eSPI.h>
+
+/*
+Parsed smooth font cache:
+ - add() runs TFT_eSPI::loadFont() once per VLW array and keeps the glyph metric tables
+ - select() swaps a cached font into a sprite without parsing or allocating
+ - release() returns the sprite to the built-in font, the tables stay cached
+
+Never call unloadFont() on a sprite with a cached font selected, it would free the cached tables.
+*/
+class FontCache {
+public:
+  typedef uint8_t Handle;
+  static const uint8_t maxFonts = 8;
+
+  Handle add(TFT_eSPI& tft, const uint8_t* vlwArray);
+  void select(TFT_eSPI& tft, Handle font) const;
+  void release(TFT_eSPI& tft) const;
+
+private:
+  struct Entry {
+    TFT_eSPI::fontMetrics metrics;
+    uint16_t* unicode;
+    uint8_t* height;
+    uint8_t* width;
+    uint8_t* xAdvance;
+    int16_t* dY;
+    int8_t* dX;
+    uint32_t* bitmap;
+  };
+
+  Entry entries[maxFonts];
+  uint8_t count = 0;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Arduino.h>
+
+/*
+Frame scheduler for loop():
+ - each content class has a target frame rate (0 = draw only when requestFrame() is called)
+ - frameDue()/frameDone() pace drawing on fixed deadlines (no drift, no catch-up bursts)
+ - sleep() delays the task until the next deadline, but never longer than the input poll interval
+ - actualFps() is measured over one second windows so it can be compared with target()
+*/
+class FrameGovernor {
+public:
+  enum Content : uint8_t {
+    CLOCK,     // seconds display only
+    SCROLLING, // bottom ticker moving
+    CONTENT_COUNT
+  };
+
+  FrameGovernor(uint8_t clockFps, uint8_t scrollingFps, uint16_t inputPollMs);
+
+  void setContent(Content content);
+  uint8_t target() const { return targets[content]; }
+
+  void requestFrame() { frameRequested = true; }
+  bool frameDue(unsigned long now) const;
+  void frameDone(unsigned long now);
+  void sleep(unsigned long now) const;
+
+  float actualFps() const { return measuredFps; }
+
+private:
+  uint8_t targets[CONTENT_COUNT];
+  uint16_t inputPollMs;
+  Content content = CLOCK;
+
+  bool frameRequested = true; // first frame is always drawn
+  unsigned long nextFrame = 0;
+
+  unsigned long windowStart = 0;
+  uint16_t windowFrames = 0;
+  float measuredFps = 0;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Layout.h"
+
+/*
+Section timings for the frame loop, to see where a frame's time goes:
+ - a Scope times the block it lives in with the CPU cycle counter (CCOUNT on the ESP32,
+   a steady_clock stand-in on the host) and records it in microseconds when it goes out of scope
+ - every section keeps its last `window` samples, report() prints p50/p99 over them,
+   plus the calls and the worst time since the previous report
+ - sections nest (drawDisplay contains the widget sections), each reports its own inclusive time
+ - each section must be recorded from one task only (TRANSFER is read from the push task's timing)
+Recording is a subtraction, a division and a store - no allocation, cheap enough to leave in.
+*/
+class FrameProfiler {
+public:
+  enum Section : uint8_t {
+    UPDATE_DATA,  // updateData(): weather, history and time intake
+    DRAW_DISPLAY, // the whole of drawDisplay()
+    FRAME_STATE,  // readFrameState()
+    BACKGROUND,   // background layer or bars repainted (only when they changed)
+    COMPOSE,      // full frame copied from the background layer
+    SUBMIT,       // dirty windows into the transfer buffer, including the wait for the bus
+    TRANSFER,     // push task: expanding and sending the windows
+    WIDGET,       // one section per frame widget from here on (WIDGET + id - firstFrameWidget)
+    SECTION_COUNT = WIDGET + WIDGET_COUNT - firstFrameWidget
+  };
+  static const uint8_t window = 128; // samples kept per section (power of two)
+
+  FrameProfiler() : cyclesPerMicro(ESP.getCpuFreqMHz()) {}
+
+  static Section widgetSection(WidgetId id) { return (Section)(WIDGET + id - firstFrameWidget); }
+
+  void record(Section section, uint32_t micros);
+  uint32_t toMicros(uint32_t cycles) const { return cycles / cyclesPerMicro; }
+  void report(Print& out);
+
+  class Scope {
+  public:
+    Scope(FrameProfiler& profiler, Section section) : profiler(profiler), section(section), start(ESP.getCycleCount()) {}
+    ~Scope() { profiler.record(section, profiler.toMicros(ESP.getCycleCount() - start)); }
+
+  private:
+    FrameProfiler& profiler;
+    Section section;
+    uint32_t start;
+  };
+
+private:
+  struct Track {
+    uint16_t samples[window]; // microseconds, saturated at 65535
+    uint8_t next;
+    uint8_t count;
+    uint32_t calls;           // since the last report
+    uint32_t worst;
+  };
+
+  uint32_t cyclesPerMicro;
+  Track tracks[SECTION_COUNT] = {};
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <TFT_eSPI.h>
+#include "DirtyRegions.h"
+#include "GreySprite.h"
+
+/*
+Asynchronous panel pushes, so drawing the next frame overlaps with sending this one:
+ - submit() copies the dirty windows of the frame sprite into a transfer buffer and returns,
+   a push task on the other core sends them while loop() carries on
+ - the sprite and the transfer buffer are the two frame buffers, only the transfer buffer is in flight
+ - both hold GreySprite indices, the push task expands them to RGB565 a row at a time as it sends
+ - wait() is the fence: it returns once the transfer buffer is free (submit() waits on it too),
+   call it before drawing to the panel directly
+ - if begin() fails (no memory for the buffer, no semaphores or task) or before it, submit() falls back to a blocking push
+The T-Display-S3 panel is on the 8-bit parallel bus, which TFT_eSPI can't drive by DMA,
+so the push task's core does the transfer instead of a DMA channel.
+*/
+class FramePush {
+public:
+  static const int16_t maxWidth = 320; // longest row that can be expanded
+
+  explicit FramePush(TFT_eSPI* tft) : tft(tft) {}
+
+  bool begin(int16_t width, int16_t height, UBaseType_t priority, BaseType_t core);
+  uint32_t submit(GreySprite& sprite, DirtyRegions& regions); // returns pixels queued
+  void wait();
+
+  uint32_t transferMicros() const { return lastTransfer; } // last transfer on the bus
+  uint32_t transfers() const { return transferCount; }
+  uint32_t stallMicros() const { return lastStall; }       // last wait in submit() for the bus
+
+private:
+  static void task(void* param);
+  uint32_t queuedPixels() const;
+  void transfer(const uint8_t* frame, int16_t stride);
+
+  TFT_eSPI* tft;
+  uint8_t* buffer = nullptr;
+  Rect windows[DirtyRegions::maxRects];
+  uint8_t windowCount = 0;
+  uint16_t line[maxWidth]; // one expanded row on its way to the panel
+  SemaphoreHandle_t queued = NULL; // given by submit(), taken by the push task
+  SemaphoreHandle_t idle = NULL;   // held while the transfer buffer is in flight
+  volatile uint32_t lastTransfer = 0;
+  volatile uint32_t transferCount = 0;
+  uint32_t lastStall = 0;
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <Arduino.h>
+
+/*
+Frame-time statistics, in microseconds between consecutive frames:
+ - frame() is called once per drawn frame with micros(), the first call only starts the clock
+ - average() is an exponential moving average (1/8 weight per frame), fps() is derived from it
+   for the FPS field, so the number is steady and a sub-millisecond frame can't divide by zero
+ - min, max and a fixed-bucket histogram cover the frames since the last report(), so a stall
+   (an HTTP fetch, a flash write) shows up even when the average hides it
+*/
+class FrameStats {
+public:
+  static const uint8_t bucketCount = 10;
+
+  void frame(unsigned long nowMicros);
+  uint32_t average() const { return averageScaled / 8; }
+  uint16_t fps() const;
+  uint32_t minimum() const { return frames ? shortest : 0; } // since the last report()
+  uint32_t maximum() const { return longest; }
+  uint32_t count() const { return frames; }
+
+  // Print the average, min/max and histogram on one line, then start a new interval
+  void report(Print& out);
+
+private:
+  void add(uint32_t micros);
+
+  unsigned long last = 0;
+  bool started = false;
+  uint32_t averageScaled = 0; // 8 x the average
+  uint32_t shortest = UINT32_MAX;
+  uint32_t longest = 0;
+  uint32_t frames = 0;
+  uint32_t buckets[bucketCount] = {};
+};
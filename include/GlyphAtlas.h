@@ -0,0 +1,46 @@
+#pragma once
+
+#include <TFT_eSPI.h>
+#include "FontCache.h"
+#include "GreySprite.h"
+
+/*
+Pre-blended glyph tiles for one text style (font, foreground, background):
+ - build() renders each character of a small charset once and keeps its ink box as grey index tiles
+ - draw() lays text out like drawString() and blits the tiles (row memcpy, no alpha blending)
+ - the ink box is painted with the background colour, so use it only where the field sits on that colour
+ - glyphs whose ink leaves their cell are not tiled
+ - draw() returns false without drawing if a character is missing, the caller falls back to drawString()
+*/
+class GlyphAtlas {
+public:
+  static const uint8_t maxGlyphs = 24;
+
+  ~GlyphAtlas() { free(pixels); }
+
+  bool build(TFT_eSPI* tft, const FontCache& fonts, FontCache::Handle font, const char* charset, uint16_t fg, uint16_t bg);
+  bool covers(const char* text) const;
+  int16_t textWidth(const char* text) const;
+  bool draw(GreySprite& target, const char* text, int32_t x, int32_t y, uint8_t datum) const;
+  size_t bytes() const { return pixelCount; }
+
+private:
+  struct Tile {
+    char code;
+    int8_t x;        // ink box relative to the cursor
+    int8_t y;
+    uint8_t w;
+    uint8_t h;
+    uint8_t advance;
+    uint32_t offset; // first pixel in pixels[]
+  };
+
+  const Tile* find(char code) const;
+
+  Tile tiles[maxGlyphs];
+  uint8_t count = 0;
+  uint8_t* pixels = nullptr; // GreySprite indices
+  size_t pixelCount = 0;
+  int16_t lineHeight = 0;
+  int16_t ascent = 0;
+};
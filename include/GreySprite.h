@@ -0,0 +1,42 @@
+#pragma once
+
+#include <TFT_eSPI.h>
+
+/*
+8-bit indexed sprite for the all-grey UI (greys[], black, white and the anti-aliased blends between them):
+ - an RGB565 grey has equal red and blue, and green within a few steps of twice that,
+   so a pixel is stored as one byte: red/blue level * 8 + green offset
+ - half the memory and fill bandwidth of a 16 bpp sprite, and the encoding is lossless for greys
+   (other colours keep their red level, blue follows red)
+ - the TFT_eSprite primitives and fonts draw into it through the overridden pixel/fill functions
+ - expand() turns index rows into RGB565 in sprite byte order through a 256-entry table, at push time
+Index sprites are copied with blit()/memcpy - pushSprite(), pushImage() and pushToSprite() of the
+base class would treat the bytes as RGB332.
+*/
+class GreySprite : public TFT_eSprite {
+public:
+  explicit GreySprite(TFT_eSPI* tft) : TFT_eSprite(tft) { setColorDepth(8); }
+
+  static uint8_t index(uint16_t colour) {
+    int8_t red = colour >> 11;
+    int8_t offset = ((colour >> 5) & 0x3F) - 2 * red + 3;
+    return red << 3 | (offset < 0 ? 0 : offset > 7 ? 7 : offset);
+  }
+  static uint16_t colour(uint8_t index);
+  static void expand(uint16_t* out, const uint8_t* in, uint32_t count);
+
+  uint8_t* pixels() { return (uint8_t*)getPointer(); }
+
+  void drawPixel(int32_t x, int32_t y, uint32_t color) override;
+  uint16_t readPixel(int32_t x, int32_t y) override;
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) override;
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) override { fillRect(x, y, w, 1, color); }
+  void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) override { fillRect(x, y, 1, h, color); }
+  void fillSprite(uint32_t color) { fillRect(0, 0, width(), height(), color); }
+
+  // Copy a w x h block of indices to (x, y), clipped to the sprite
+  void blit(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t* data, int32_t stride);
+
+private:
+  static const uint16_t* table();
+};
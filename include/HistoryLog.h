@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "TempHistory.h"
+
+/*
+Append-only temperature log on LittleFS, replayed into TempHistory at boot:
+ - samples are buffered in RAM and written as one CRC'd record per recordSamples (30 minutes),
+   so the flash sees 48 small appends a day (a reboot loses at most the unwritten half hour)
+ - records alternate between two files: when the active file holds a week of records the other
+   one is truncated and takes over, so the log never grows past two weeks (about 19 KB)
+ - LittleFS spreads block erases across the partition and only commits an append on close(),
+   records with a bad CRC or from the other unit system are skipped on replay
+ - replay places records by their epoch: time between records with no samples goes into the history
+   as gaps, and records more than a week older than the newest one are not replayed
+ - a file that replay couldn't read to the end is never appended to, the next record starts the other file
+*/
+class HistoryLog {
+public:
+  static const uint8_t recordSamples = 6;
+  static const uint16_t recordsPerFile = 336; // 7 days of 30 minute records
+
+  // Mount the file system (formats an unformatted partition on the first boot)
+  bool begin(bool imperial);
+
+  // Push every logged sample into history, oldest first, returns the number of samples
+  uint16_t replay(TempHistory& history);
+
+  // Buffer a sample, a full record is appended to the active file (epoch 0 when the clock isn't set)
+  void append(float value, uint32_t epoch);
+
+  // Epoch the sample after the last replayed one was due at (0 if unknown)
+  uint32_t replayedUntil() const { return replayEnd; }
+
+private:
+  struct Record {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t flags;  // bit 0: imperial
+    uint32_t seq;   // increases across both files
+    uint32_t epoch; // time of the first sample (unix, 0 if the clock wasn't set)
+    int16_t samples[recordSamples]; // centi-degrees
+    uint32_t crc;   // CRC-32 of everything above
+  };
+
+  // Replay position in time (0 = unknown) and the oldest record epoch still inside the longest range
+  struct Cursor {
+    uint32_t next;
+    uint32_t cutoff;
+  };
+
+  static uint32_t crc32(const uint8_t* data, size_t length);
+  static bool valid(const Record& record);
+  static bool firstSeq(const char* path, uint32_t& seq);
+  static uint32_t lastEpoch(const char* path);
+  uint16_t replayFile(const char* path, TempHistory& history, Cursor& cursor, uint16_t& records, bool& clean);
+  void writeRecord();
+
+  bool mounted = false;
+  uint8_t flags = 0;
+
+  uint8_t active = 0;       // file index appends go to
+  uint16_t activeCount = 0; // records in the active file
+  bool rotate = false;      // the active file is damaged, the next record starts the other one
+  uint32_t nextSeq = 0;
+  uint32_t replayEnd = 0;
+
+  Record pending = {};
+  uint8_t pendingCount = 0;
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <Arduino.h>
+#include "RingBuffer.h"
+#include "SlidingMinMax.h"
+
+// One history entry in centi-degrees (int16 covers +-327.67 degrees)
+struct TempBucket {
+  int16_t low;
+  int16_t avg;
+  int16_t high;
+};
+
+// A bucket with no samples (missed ticks, device off): low above high, so it never moves a min/max
+const TempBucket noTemp = { INT16_MAX, 0, INT16_MIN };
+inline bool hasTemp(const TempBucket& bucket) { return bucket.low <= bucket.high; }
+
+/*
+One resolution of the temperature history (RRDtool style round-robin archive):
+ - add() consolidates Samples inputs into one min/avg/max bucket, completed buckets go into
+   a RingBuffer of Capacity entries and are handed back so the next coarser tier can consume them
+ - the view is the newest Capacity buckets, with the bucket still being filled standing in
+   for the oldest one, so a coarse tier shows data before its first bucket completes
+ - low()/high() cover the view: SlidingMinMax over the newest Capacity - 1 complete buckets,
+   plus either the pending bucket or the oldest complete one
+ - noTemp inputs keep their place in time, a bucket made only of them is noTemp too
+*/
+template <uint16_t Capacity, uint8_t Samples>
+class HistoryTier {
+public:
+  static_assert(Capacity >= 2 && Samples >= 1, "tier needs two buckets and one sample per bucket");
+  static constexpr uint16_t capacity() { return Capacity; }
+
+  // Consolidate one input, returns true (and the bucket in completed) when a bucket fills
+  bool add(const TempBucket& in, TempBucket& completed) {
+    if (pendingCount == 0) {
+      pendingLow = in.low;
+      pendingHigh = in.high;
+      pendingSum = 0;
+      pendingTemps = 0;
+    } else {
+      pendingLow = min(pendingLow, in.low);
+      pendingHigh = max(pendingHigh, in.high);
+    }
+    if (hasTemp(in)) {
+      pendingSum += in.avg;
+      pendingTemps++;
+    }
+    pendingCount++;
+    if (pendingCount < Samples) return false;
+
+    completed = pending();
+    pendingCount = 0;
+    buckets.push(completed);
+    extremes.push(completed.low, completed.high);
+    return true;
+  }
+
+  bool empty() const { return size() == 0; }
+  bool hasTemps() const { return !empty() && low() <= high(); } // false while the view holds only noTemp
+  uint16_t size() const { return shownComplete() + (pendingCount ? 1 : 0); }
+
+  // View entries, oldest first
+  TempBucket operator[](uint16_t index) const {
+    uint16_t complete = shownComplete();
+    if (index < complete) return buckets[buckets.size() - complete + index];
+    return pending();
+  }
+
+  // Range of the view (only valid when hasTemps())
+  int16_t low() const {
+    int16_t value = INT16_MAX;
+    if (!extremes.empty()) value = extremes.minimum();
+    if (pendingCount) value = min(value, pendingLow);
+    else if (buckets.full()) value = min(value, buckets.oldest().low);
+    return value;
+  }
+
+  int16_t high() const {
+    int16_t value = INT16_MIN;
+    if (!extremes.empty()) value = extremes.maximum();
+    if (pendingCount) value = max(value, pendingHigh);
+    else if (buckets.full()) value = max(value, buckets.oldest().high);
+    return value;
+  }
+
+private:
+  uint16_t shownComplete() const {
+    return pendingCount ? min<uint16_t>(buckets.size(), Capacity - 1) : buckets.size();
+  }
+
+  TempBucket pending() const {
+    if (pendingTemps == 0) return noTemp;
+    int16_t avg = (int16_t)lroundf((float)pendingSum / pendingTemps);
+    return { pendingLow, avg, pendingHigh };
+  }
+
+  RingBuffer<TempBucket, Capacity> buckets;
+  SlidingMinMax<int16_t, Capacity - 1> extremes; // newest Capacity - 1 complete buckets
+
+  int16_t pendingLow = 0;
+  int16_t pendingHigh = 0;
+  int32_t pendingSum = 0;
+  uint8_t pendingCount = 0;
+  uint8_t pendingTemps = 0; // inputs that were not noTemp
+};
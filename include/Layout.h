@@ -0,0 +1,183 @@
+#pragma once
+
+#include <TFT_eSPI.h>
+#include "DirtyRegions.h"
+
+/*
+Compile-time screen layout (320x170 landscape):
+ - shapes and labels make up the static background layer, drawn once into bgSprite
+ - widgets are the values filled in by the renderer, each with its anchor, text style and bounds
+ - widget bounds are the dirty rectangles pushed when a value changes
+ - colours are slots: 0-12 index greys[], then black and white (see colourSlots)
+ - widgets that redraw often can list the characters they use, so they can be pre-rendered
+Everything is constexpr, so positions cost nothing at runtime and another layout is just another table.
+*/
+
+// Colour slots
+const uint8_t SLOT_BLACK = 13;
+const uint8_t SLOT_WHITE = 14;
+const uint8_t colourSlots = 15;
+
+enum FontId : uint8_t {
+  FONT_GLCD, // built-in font
+  FONT_TINY,
+  FONT_18,
+  FONT_BIG,
+  FONT_MIDLE,
+  FONT_COUNT
+};
+
+struct TextStyle {
+  FontId font;
+  uint8_t datum;
+  uint8_t fg;
+  uint8_t bg;
+};
+
+enum ShapeKind : uint8_t {
+  SHAPE_LINE,         // from (x, y) to (x + w, y + h)
+  SHAPE_RECT,
+  SHAPE_ROUND_RECT,
+  SHAPE_SMOOTH_RECT,  // anti-aliased corners blended into bg
+  SHAPE_CIRCLE        // centre (x, y)
+};
+
+struct Shape {
+  ShapeKind kind;
+  Rect area;
+  uint8_t radius;
+  uint8_t colour;
+  uint8_t bg;
+};
+
+struct Label {
+  int16_t x;
+  int16_t y;
+  TextStyle style;
+  const char* text;
+};
+
+enum WidgetId : uint8_t {
+  // Background layer (change with settings, not with data)
+  W_UNITS,
+  W_LOCATION,
+  W_RANGE,
+  // Frame layer
+  W_CLOCK,
+  W_WIFI,
+  W_TEMPERATURE,
+  W_SECONDS,
+  W_FPS,
+  W_MIN,
+  W_MAX,
+  W_GRAPH,   // bars, see GraphGeometry
+  W_METRIC0,
+  W_METRIC1,
+  W_METRIC2,
+  W_SCROLLER, // anchor is the text position inside the strip, bounds are the strip
+  W_UPDATES,
+  WIDGET_COUNT
+};
+
+const uint8_t firstFrameWidget = W_CLOCK;
+
+struct Widget {
+  WidgetId id;
+  int16_t x;
+  int16_t y;
+  TextStyle style;
+  Rect bounds;
+  const char* glyphs; // characters worth pre-rendering (GlyphAtlas), if any
+};
+
+// Bar chart: column c, block b (0 = bottom) is drawn at (x + c * columnPitch, baseline - b * blockPitch)
+struct GraphGeometry {
+  int16_t x;
+  int16_t baseline;
+  uint8_t columnPitch;
+  uint8_t blockPitch;
+  uint8_t blockWidth;
+  uint8_t blockHeight;
+  uint8_t colour;
+};
+
+struct Layout {
+  const Shape* shapes;
+  uint8_t shapeCount;
+  const Label* labels;
+  uint8_t labelCount;
+  const Widget* widgets; // indexed by WidgetId
+  GraphGeometry graph;
+
+  constexpr const Widget& widget(WidgetId id) const { return widgets[id]; }
+};
+
+/*************************************************************
+*********************** DEFAULT LAYOUT ***********************
+**************************************************************/
+
+namespace defaultLayout {
+  // Metric boxes are 54 wide on a 60 pixel pitch
+  constexpr int16_t metricX(uint8_t i) { return 144 + i * 60; }
+
+  constexpr Shape shapes[] = {
+    { SHAPE_LINE, { 138, 10, 0, 154 }, 0, 6, 0 },                    // divider
+    { SHAPE_CIRCLE, { 13, 54, 0, 0 }, 2, 2, 0 },                     // degree sign
+    { SHAPE_ROUND_RECT, { 92, 132, 23, 22 }, 2, 2, 0 },              // seconds box
+    { SHAPE_RECT, { 144, 28, 84, 2 }, 0, 10, 0 },                    // under the range label
+    { SHAPE_SMOOTH_RECT, { 144, 34, 174, 60 }, 3, 10, SLOT_BLACK },  // graph box
+    { SHAPE_LINE, { 170, 39, 0, 49 }, 0, SLOT_WHITE, 0 },            // graph y axis
+    { SHAPE_LINE, { 170, 88, 144, 0 }, 0, SLOT_WHITE, 0 },           // graph x axis
+    { SHAPE_SMOOTH_RECT, { metricX(0), 100, 54, 32 }, 3, 9, SLOT_BLACK },
+    { SHAPE_SMOOTH_RECT, { metricX(1), 100, 54, 32 }, 3, 9, SLOT_BLACK },
+    { SHAPE_SMOOTH_RECT, { metricX(2), 100, 54, 32 }, 3, 9, SLOT_BLACK },
+    { SHAPE_SMOOTH_RECT, { 144, 148, 174, 16 }, 2, 10, SLOT_BLACK }, // status bar
+  };
+
+  constexpr Label labels[] = {
+    { 6, 10, { FONT_MIDLE, TL_DATUM, 1, SLOT_BLACK }, "WEATHER" },
+    { 11, 110, { FONT_18, TL_DATUM, 7, SLOT_BLACK }, "LOC:" },
+    { 85, 10, { FONT_GLCD, TL_DATUM, 5, SLOT_BLACK }, "INTERNET" },
+    { 85, 20, { FONT_GLCD, TL_DATUM, 5, SLOT_BLACK }, "STATION" },
+    { 10, 37, { FONT_GLCD, TL_DATUM, 5, SLOT_BLACK }, "WiFi signal:" },
+    { 158, 42, { FONT_GLCD, MC_DATUM, 2, 10 }, "MAX" },
+    { 158, 86, { FONT_GLCD, MC_DATUM, 2, 10 }, "MIN" },
+    { 158, 65, { FONT_18, MC_DATUM, 7, 10 }, "T" },
+    { metricX(0) + 27, 107, { FONT_GLCD, MC_DATUM, 3, 9 }, "HUMID" },
+    { metricX(1) + 27, 107, { FONT_GLCD, MC_DATUM, 3, 9 }, "PRESS" },
+    { metricX(2) + 27, 107, { FONT_GLCD, MC_DATUM, 3, 9 }, "WIND" },
+    { 182, 142, { FONT_GLCD, MC_DATUM, 4, SLOT_BLACK }, "CURRENT INFO" },
+  };
+
+  constexpr Widget widgets[WIDGET_COUNT] = {
+    { W_UNITS, 19, 52, { FONT_18, TL_DATUM, 2, SLOT_BLACK }, { 19, 52, 12, 18 }, nullptr },
+    { W_LOCATION, 45, 110, { FONT_18, TL_DATUM, 3, SLOT_BLACK }, { 45, 110, 90, 18 }, nullptr },
+    { W_RANGE, 144, 10, { FONT_18, TL_DATUM, 1, SLOT_BLACK }, { 144, 10, 106, 18 }, nullptr },
+    { W_CLOCK, 10, 132, { FONT_TINY, TL_DATUM, 4, SLOT_BLACK }, { 10, 132, 80, 38 }, nullptr },
+    { W_WIFI, 85, 37, { FONT_GLCD, TL_DATUM, 5, SLOT_BLACK }, { 85, 37, 48, 8 }, nullptr },
+    { W_TEMPERATURE, 74, 82, { FONT_BIG, MC_DATUM, 0, SLOT_BLACK }, { 18, 46, 112, 50 }, "0123456789.-" },
+    { W_SECONDS, 103, 145, { FONT_18, MC_DATUM, SLOT_BLACK, 2 }, { 92, 132, 23, 22 }, "0123456789-" },
+    { W_FPS, 92, 157, { FONT_GLCD, TL_DATUM, 7, SLOT_BLACK }, { 92, 157, 42, 8 }, nullptr },
+    { W_MIN, 252, 10, { FONT_GLCD, TL_DATUM, 3, SLOT_BLACK }, { 252, 10, 66, 8 }, nullptr },
+    { W_MAX, 252, 20, { FONT_GLCD, TL_DATUM, 3, SLOT_BLACK }, { 252, 20, 66, 8 }, nullptr },
+    { W_GRAPH, 0, 0, { FONT_GLCD, TL_DATUM, 2, 10 }, { 173, 39, 142, 47 }, nullptr },
+    { W_METRIC0, metricX(0) + 27, 124, { FONT_18, MC_DATUM, 2, 9 }, { metricX(0), 114, 54, 18 }, "0123456789-%hPam/s" },
+    { W_METRIC1, metricX(1) + 27, 124, { FONT_18, MC_DATUM, 2, 9 }, { metricX(1), 114, 54, 18 }, "0123456789-%hPam/s" },
+    { W_METRIC2, metricX(2) + 27, 124, { FONT_18, MC_DATUM, 2, 9 }, { metricX(2), 114, 54, 18 }, "0123456789-%hPam/s" },
+    { W_SCROLLER, 0, 4, { FONT_GLCD, TL_DATUM, 1, 10 }, { 148, 150, 164, 15 }, nullptr },
+    { W_UPDATES, 285, 142, { FONT_GLCD, MC_DATUM, 7, SLOT_BLACK }, { 252, 138, 66, 8 }, nullptr },
+  };
+
+  constexpr Layout layout = {
+    shapes, sizeof(shapes) / sizeof(shapes[0]),
+    labels, sizeof(labels) / sizeof(labels[0]),
+    widgets,
+    { 173, 83, 6, 4, 4, 3, 2 },
+  };
+}
+
+// The table is indexed by id, check the order matches
+constexpr bool widgetsInOrder(const Widget* widgets, uint8_t i = 0) {
+  return i == WIDGET_COUNT || (widgets[i].id == i && widgetsInOrder(widgets, i + 1));
+}
+static_assert(widgetsInOrder(defaultLayout::widgets), "widgets[] must be in WidgetId order");
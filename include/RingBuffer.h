@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Arduino.h>
+
+/*
+Fixed-capacity FIFO that overwrites its oldest entry when full:
+ - push() is O(1), nothing is shifted or copied
+ - popOldest()/popNewest() remove from either end, so it also works as a bounded deque
+ - operator[] indexes from the oldest (0) to the newest (size() - 1)
+ - storage is a plain array inside the object, no heap
+*/
+template <typename T, uint16_t Capacity>
+class RingBuffer {
+public:
+  static_assert(Capacity > 0, "RingBuffer needs a capacity");
+
+  static constexpr uint16_t capacity() { return Capacity; }
+  uint16_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  bool full() const { return count == Capacity; }
+
+  // Append, returns true when the oldest entry was dropped to make room
+  bool push(const T& value) {
+    bool dropped = full();
+    data[head] = value;
+    head = head + 1 == Capacity ? 0 : head + 1;
+    if (!dropped) count++;
+    return dropped;
+  }
+
+  // Remove from either end (the buffer must not be empty)
+  void popOldest() { count--; }
+  void popNewest() {
+    head = head == 0 ? Capacity - 1 : head - 1;
+    count--;
+  }
+
+  const T& operator[](uint16_t index) const {
+    uint16_t pos = head + Capacity - count + index;
+    return data[pos >= Capacity ? pos - Capacity : pos];
+  }
+  const T& oldest() const { return (*this)[0]; }
+  const T& newest() const { return (*this)[count - 1]; }
+
+  void clear() { head = 0; count = 0; }
+
+private:
+  T data[Capacity] = {};
+  uint16_t head = 0; // next slot to write
+  uint16_t count = 0;
+};
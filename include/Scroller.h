@@ -0,0 +1,38 @@
+#pragma once
+
+#include <TFT_eSPI.h>
+#include "GreySprite.h"
+
+/*
+Ticker strip for the bottom status bar:
+ - setMessage() renders the text once into a strip sprite, only when the text changed
+ - draw() copies the visible window of the strip into the frame row by row (blank parts are filled)
+ - position() follows millis() at a fixed speed, so scrolling doesn't depend on the frame rate
+Messages wider than maxTextWidth are cut off.
+*/
+class Scroller {
+public:
+  static const int16_t maxTextWidth = 640;
+
+  explicit Scroller(TFT_eSPI* tft) : strip(tft) {}
+
+  bool begin(int16_t windowWidth, int16_t windowHeight, uint16_t bg, uint16_t pixelsPerSecond);
+  TFT_eSprite& canvas() { return strip; } // select the font and colours before setMessage()
+  bool shows(const String& message) const { return message == text; }
+  bool setMessage(const String& message, int16_t textY, unsigned long now);
+  bool active() const { return textWidth > 0; }
+
+  int16_t position(unsigned long now) const; // left edge of the text relative to the window
+  void draw(GreySprite& target, int16_t x, int16_t y, int16_t textX);
+
+private:
+  GreySprite strip;
+  String text;
+  int16_t windowWidth = 0;
+  int16_t windowHeight = 0;
+  uint16_t speed = 0;
+  uint16_t bg = 0;
+  int16_t textWidth = 0;
+  uint8_t blank = 0;          // background index
+  unsigned long started = 0;  // when the current message entered on the right
+};
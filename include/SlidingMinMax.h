@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Arduino.h>
+#include "RingBuffer.h"
+
+/*
+Minimum and maximum of the last Window values pushed, in amortised O(1):
+ - two monotonic deques hold only the values that can still become the extreme
+   (ascending for the minimum, descending for the maximum), tagged with their sequence number
+ - push() drops entries that left the window from the front, and entries the new value
+   beats from the back, so each value is added and removed at most once per deque
+ - push(low, high) tracks ranges (e.g. min/max aggregates): the minimum of the lows
+   and the maximum of the highs
+*/
+template <typename T, uint16_t Window>
+class SlidingMinMax {
+public:
+  void push(const T& value) { push(value, value); }
+
+  void push(const T& low, const T& high) {
+    uint16_t seq = next++;
+    evict(lows, seq);
+    evict(highs, seq);
+    while (!lows.empty() && !(lows.newest().value < low)) lows.popNewest();
+    while (!highs.empty() && !(high < highs.newest().value)) highs.popNewest();
+    lows.push({ seq, low });
+    highs.push({ seq, high });
+  }
+
+  bool empty() const { return lows.empty(); }
+  const T& minimum() const { return lows.oldest().value; }
+  const T& maximum() const { return highs.oldest().value; }
+
+  void clear() {
+    lows.clear();
+    highs.clear();
+    next = 0;
+  }
+
+private:
+  struct Entry {
+    uint16_t seq; // wraps, only differences within the window are used
+    T value;
+  };
+
+  // Drop the front entries that are Window or more pushes older than seq
+  static void evict(RingBuffer<Entry, Window>& deque, uint16_t seq) {
+    while (!deque.empty() && (uint16_t)(seq - deque.oldest().seq) >= Window) deque.popOldest();
+  }
+
+  RingBuffer<Entry, Window> lows;
+  RingBuffer<Entry, Window> highs;
+  uint16_t next = 0;
+};
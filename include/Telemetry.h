@@ -0,0 +1,66 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+Binary telemetry frame, written to Serial between the text lines:
+  0xA5 0x5A | version | payload length | payload (little-endian) | CRC-32 of version..payload (little-endian)
+ - the version 1 payload is Record, field by field in declaration order (recordBytes)
+ - later versions only append fields: a decoder reads the fields it knows and the length skips the rest
+ - Parser finds frames in a byte stream with log text around them. The text may contain the sync
+   bytes too (an SSID, UTF-8 such as "å" = C3 A5): a false start fails the sync1, length or CRC check
+ - on any failed check only the first byte is dropped, the parser rescans from the next sync byte,
+   so neither stray sync bytes nor a corrupted length can swallow the good frame that follows
+   (a false start's length can hold that frame back until enough later bytes have arrived)
+No Arduino dependencies, tools/telemetry_decode.cpp builds this file on the host as it is.
+*/
+class Telemetry {
+public:
+  static const uint8_t sync0 = 0xA5;
+  static const uint8_t sync1 = 0x5A;
+  static const uint8_t version = 1;
+  static const uint8_t headerBytes = 4;
+  static const uint8_t crcBytes = 4;
+  static const uint8_t recordBytes = 43;
+  static const uint16_t frameBytes = headerBytes + recordBytes + crcBytes;
+  static const uint16_t maxFrameBytes = headerBytes + 255 + crcBytes;
+
+  struct Record {
+    uint32_t sequence;      // frames sent since boot, gaps mean lost frames
+    uint32_t uptimeMs;
+    uint32_t frameAverageUs; // moving average of the frame time
+    uint32_t frameMinUs;     // since the previous frame (0 when nothing was drawn)
+    uint32_t frameMaxUs;
+    uint32_t frames;         // drawn since the previous frame
+    uint32_t heapFree;
+    uint32_t heapLargestBlock;
+    uint32_t fetchConnectMs; // last OWM request (connect is 0 on a reused connection)
+    uint32_t fetchRequestMs;
+    int8_t rssi;             // dBm, 0 when not connected
+    uint8_t weatherRetries;  // current retry counts (reset by a success)
+    uint8_t timeSyncRetries;
+  };
+
+  // Write one frame into out (frameBytes long), returns its length
+  static size_t encode(const Record& record, uint8_t* out);
+
+  class Parser {
+  public:
+    // Feed one byte, true when it completed a valid frame (decoded into record)
+    bool push(uint8_t byte, Record& record);
+    uint32_t crcErrors() const { return errors; }
+
+  private:
+    void drop(uint16_t bytes); // discard bytes from the front, then up to the next sync0
+
+    uint8_t frame[maxFrameBytes];
+    uint16_t used = 0;
+    uint32_t errors = 0;
+  };
+
+  static uint32_t crc32(const uint8_t* data, size_t length);
+
+private:
+  static void decode(const uint8_t* payload, Record& record);
+};
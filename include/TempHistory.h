@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Arduino.h>
+#include "HistoryTier.h"
+
+/*
+Multi-resolution temperature history for the graph (about 1.5 KB for a week, min/max deques included):
+ - every 5 minute sample feeds the raw tier, whose completed entries feed the 30 minute tier,
+   whose completed buckets feed the 3 hour tier
+ - each range shows one tier: 2 hours of samples, 12 hours of 30 minute buckets, 7 days of 3 hour buckets
+ - skip() pushes noTemp samples for ticks with no reading, so later samples stay in their place in time
+ - minimum()/maximum() are the lowest low and highest high of the selected range
+ - graph() projects the bucket averages onto columns bars of 0..levels blocks, newest on the right.
+   It is recomputed only on the first call after a change; ranges with more buckets than
+   columns average their share per bar
+*/
+class TempHistory {
+public:
+  enum Range : uint8_t {
+    LAST_2_HOURS,
+    LAST_12_HOURS,
+    LAST_7_DAYS,
+    RANGE_COUNT
+  };
+
+  static const uint8_t columns = 24;
+  static const uint8_t levels = 12;
+  static const uint16_t sampleSeconds = 300;          // one push() per 5 minute weather tick
+  static const uint32_t spanSeconds = 7UL * 24 * 3600; // the longest range
+
+  void push(float value);
+  void skip(uint32_t samples); // missed ticks, shown as empty columns
+
+  void setRange(Range newRange);
+  void nextRange() { setRange((Range)((selected + 1) % RANGE_COUNT)); }
+  void previousRange() { setRange((Range)((selected + RANGE_COUNT - 1) % RANGE_COUNT)); }
+  Range range() const { return selected; }
+  const char* label() const;
+
+  bool empty() const;    // no readings in the selected range (skipped ticks don't count)
+  float minimum() const; // only valid when not empty()
+  float maximum() const;
+
+  // Bar heights, columns entries (0 = no data in that column yet)
+  const uint8_t* graph();
+
+private:
+  void add(const TempBucket& sample);
+  template <class Tier> void project(const Tier& tier);
+
+  HistoryTier<24, 1> raw;       // 5 minute samples, 2 hours
+  HistoryTier<24, 6> halfHours; // 30 minute buckets, 12 hours
+  HistoryTier<56, 6> threeHours; // 3 hour buckets, 7 days
+
+  Range selected = LAST_12_HOURS;
+  uint8_t bars[columns] = {};
+  bool graphDirty = false;
+};
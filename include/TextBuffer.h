@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Arduino.h>
+
+/*
+Fixed-capacity text for the draw path:
+ - add() appends text and numbers in place, anything past Capacity - 1 characters is cut off
+ - numbers are formatted like the String constructors (String(int), String(float, decimals))
+ - copies and compares as a value, so it can also remember what was drawn last
+ - storage is a plain array inside the object, no heap
+*/
+template <uint8_t Capacity>
+class TextBuffer {
+public:
+  static_assert(Capacity > 1, "TextBuffer needs room for a character");
+
+  TextBuffer() { clear(); }
+  explicit TextBuffer(const char* initial) { clear(); add(initial); }
+
+  const char* c_str() const { return text; }
+  uint8_t length() const { return used; }
+  bool operator==(const TextBuffer& other) const { return strcmp(text, other.text) == 0; }
+  bool operator!=(const TextBuffer& other) const { return !(*this == other); }
+
+  TextBuffer& clear() {
+    used = 0;
+    text[0] = 0;
+    return *this;
+  }
+
+  TextBuffer& add(const char* more) {
+    while (*more && used < Capacity - 1) text[used++] = *more++;
+    text[used] = 0;
+    return *this;
+  }
+
+  TextBuffer& add(char c) {
+    if (used < Capacity - 1) text[used++] = c;
+    text[used] = 0;
+    return *this;
+  }
+
+  TextBuffer& add(long value) { return format("%ld", value); }
+  TextBuffer& add(int value) { return add((long)value); }
+  TextBuffer& add(unsigned long value) { return format("%lu", value); }
+  TextBuffer& add(float value, uint8_t decimals) { return format("%.*f", decimals, (double)value); }
+
+  // printf-style append
+  __attribute__((format(printf, 2, 3))) TextBuffer& format(const char* pattern, ...) {
+    va_list args;
+    va_start(args, pattern);
+    int written = vsnprintf(text + used, Capacity - used, pattern, args);
+    va_end(args);
+    if (written > 0) used = written < Capacity - used ? used + written : Capacity - 1;
+    return *this;
+  }
+
+private:
+  char text[Capacity];
+  uint8_t used;
+};
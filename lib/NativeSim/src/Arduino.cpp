@@ -0,0 +1,294 @@
+#include "Arduino.h"
+#include "esp_sntp.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+/*************************************************************
+*********************** SIMULATED CLOCK **********************
+**************************************************************/
+
+/*
+Background tasks run as threads in lockstep with the loop() thread:
+ - the loop() thread owns the clock, delay() there fast-forwards it
+ - delay() in a task blocks until the clock reaches its wake time
+ - after advancing, the loop() thread waits until every woken task is asleep again,
+   so task work lands at the same simulated time on every run
+*/
+extern "C" time_t __real_time(time_t* out);
+
+namespace sim {
+  bool deterministic = false;
+
+  static const auto startTime = std::chrono::steady_clock::now();
+  static const std::thread::id mainThread = std::this_thread::get_id();
+  static std::atomic<uint64_t> skippedMicros(0); // time fast-forwarded by delay()
+  static time_t epochBase = 0;                   // wall clock at millis() == 0
+
+  // Never destroyed: tasks may still be asleep on them when main() returns
+  static std::mutex& clockMutex = *new std::mutex;
+  static std::condition_variable& clockCv = *new std::condition_variable;
+
+  struct Sleeper {
+    uint64_t wake;
+    bool woken;
+  };
+  static std::vector<Sleeper*> sleepers;
+  static int runningTasks = 0; // tasks that are not asleep
+
+  uint64_t micros() {
+    uint64_t elapsed = 0;
+    if (!deterministic) {
+      elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+    }
+    return elapsed + skippedMicros.load();
+  }
+
+  uint32_t millis() {
+    return (uint32_t)(micros() / 1000);
+  }
+
+  static void wakeDueLocked() {
+    const uint64_t now = micros();
+    for (Sleeper* s : sleepers) {
+      if (!s->woken && s->wake <= now) {
+        s->woken = true;
+        runningTasks++;
+      }
+    }
+  }
+
+  void advance(uint32_t ms) {
+    std::unique_lock<std::mutex> lock(clockMutex);
+    skippedMicros += (uint64_t)ms * 1000;
+    wakeDueLocked();
+    clockCv.notify_all();
+    clockCv.wait(lock, [] { return runningTasks == 0; });
+  }
+
+  void sleepFor(uint32_t ms) {
+    if (std::this_thread::get_id() == mainThread) {
+      advance(ms);
+      return;
+    }
+
+    std::unique_lock<std::mutex> lock(clockMutex);
+    Sleeper self = { micros() + (uint64_t)ms * 1000, false };
+    sleepers.push_back(&self);
+    runningTasks--;
+    clockCv.notify_all();
+    while (!self.woken) {
+      if (deterministic) {
+        clockCv.wait(lock);
+      } else {
+        clockCv.wait_for(lock, std::chrono::milliseconds(1));
+        if (!self.woken && micros() >= self.wake) {
+          self.woken = true;
+          runningTasks++;
+        }
+      }
+    }
+    sleepers.erase(std::find(sleepers.begin(), sleepers.end(), &self));
+  }
+
+  void startTask(void (*fn)(void*), void* param) {
+    {
+      std::lock_guard<std::mutex> lock(clockMutex);
+      runningTasks++;
+    }
+    std::thread([fn, param] {
+      fn(param);
+      std::lock_guard<std::mutex> lock(clockMutex);
+      runningTasks--;
+      clockCv.notify_all();
+    }).detach();
+
+    // Let the new task run up to its first delay() before the creator continues
+    if (std::this_thread::get_id() == mainThread) {
+      std::unique_lock<std::mutex> lock(clockMutex);
+      clockCv.wait(lock, [] { return runningTasks == 0; });
+    }
+  }
+
+  time_t epoch() {
+    if (epochBase == 0) {
+      epochBase = deterministic ? (time_t)1748779200 : __real_time(nullptr); // 2025-06-01 12:00:00 for golden runs
+    }
+    return epochBase + millis() / 1000;
+  }
+
+  void setEpoch(time_t t) {
+    epochBase = t - millis() / 1000;
+  }
+}
+
+/*************************************************************
+************************ CORE HELPERS ************************
+**************************************************************/
+
+String::String(long value, unsigned char base) {
+  char buf[34];
+  if (base == 10) snprintf(buf, sizeof(buf), "%ld", value);
+  else if (base == 16) snprintf(buf, sizeof(buf), "%lx", value);
+  else snprintf(buf, sizeof(buf), "%lo", value);
+  assign(buf, (unsigned int)strlen(buf));
+}
+
+String::String(unsigned long value, unsigned char base) {
+  char buf[34];
+  if (base == 10) snprintf(buf, sizeof(buf), "%lu", value);
+  else if (base == 16) snprintf(buf, sizeof(buf), "%lx", value);
+  else snprintf(buf, sizeof(buf), "%lo", value);
+  assign(buf, (unsigned int)strlen(buf));
+}
+
+String::String(double value, unsigned int decimalPlaces) {
+  char buf[48];
+  snprintf(buf, sizeof(buf), "%.*f", (int)decimalPlaces, value);
+  assign(buf, (unsigned int)strlen(buf));
+}
+
+// Grow like WString::changeBuffer(): exact request rounded up to 16 bytes, realloc keeps the text
+bool String::reserve(unsigned int size) {
+  if (size <= capacity_) return true;
+  size_t bytes = (size + 16) & ~(size_t)0xF;
+  char* grown = (char*)realloc(heap_, bytes);
+  if (!grown) return false;
+  if (!heap_) memcpy(grown, sso_, len_ + 1);
+  heap_ = grown;
+  capacity_ = (unsigned int)bytes - 1;
+  return true;
+}
+
+bool String::assign(const char* data, unsigned int len) {
+  if (!reserve(len)) return false;
+  memmove(buffer(), data, len);
+  len_ = len;
+  buffer()[len_] = 0;
+  return true;
+}
+
+bool String::append(const char* data, unsigned int len) {
+  // data may point into this string, which reserve() can move
+  bool inside = data >= buffer() && data < buffer() + len_;
+  size_t offset = inside ? (size_t)(data - buffer()) : 0;
+  if (!reserve(len_ + len)) return false;
+  if (inside) data = buffer() + offset;
+  memmove(buffer() + len_, data, len);
+  len_ += len;
+  buffer()[len_] = 0;
+  return true;
+}
+
+void String::take(String& str) {
+  memcpy(sso_, str.sso_, sizeof(sso_));
+  heap_ = str.heap_;
+  capacity_ = str.capacity_;
+  len_ = str.len_;
+  str.heap_ = nullptr;
+  str.capacity_ = ssoChars;
+  str.len_ = 0;
+  str.sso_[0] = 0;
+}
+
+void String::trim() {
+  const char* text = buffer();
+  unsigned int first = 0;
+  unsigned int last = len_;
+  while (first < last && isspace((unsigned char)text[first])) first++;
+  while (last > first && isspace((unsigned char)text[last - 1])) last--;
+  assign(text + first, last - first);
+}
+
+size_t Print::printf(const char* format, ...) {
+  char buf[256];
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  if (len < 0) return 0;
+  return write((const uint8_t*)buf, std::min<size_t>((size_t)len, sizeof(buf) - 1));
+}
+
+char* dtostrf(double val, signed char width, unsigned char prec, char* sout) {
+  sprintf(sout, "%*.*f", width, prec, val);
+  return sout;
+}
+
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+size_t strlcpy(char* dst, const char* src, size_t size) {
+  size_t len = strlen(src);
+  if (size > 0) {
+    size_t n = std::min(len, size - 1);
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return len;
+}
+#endif
+
+// SNTP answers ntpSyncMs after configTime(), until then the clock reads as unset (like the 1970 epoch)
+static const uint32_t ntpSyncMs = 400;
+static bool ntpStarted = false;
+static uint32_t ntpSyncedAt = 0;
+static sntp_sync_time_cb_t ntpCallback = nullptr;
+
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback) {
+  ntpCallback = callback;
+}
+
+// The reply arrives on a background task, like the lwIP SNTP client
+static void ntpTask(void*) {
+  delay(ntpSyncMs);
+  if (ntpCallback) {
+    struct timeval tv = { sim::epoch(), 0 };
+    ntpCallback(&tv);
+  }
+}
+
+// time() callers see the simulated clock, like time() after SNTP has set the system clock on the device
+extern "C" time_t __wrap_time(time_t* out) {
+  time_t now = sim::epoch();
+  if (out) *out = now;
+  return now;
+}
+
+// esp32-hal-time sets TZ from the offsets, the simulated clock already reads local time so TZ is UTC
+void configTime(long, int, const char*, const char*, const char*) {
+  setenv("TZ", "UTC0", 1);
+  tzset();
+  if (ntpStarted) return;
+  ntpStarted = true;
+  ntpSyncedAt = sim::millis() + ntpSyncMs;
+  sim::startTask(ntpTask, nullptr);
+}
+
+// Polls every 10ms for up to ms, like esp32-hal-time
+bool getLocalTime(struct tm* info, uint32_t ms) {
+  uint32_t start = sim::millis();
+  while (!ntpStarted || (int32_t)(sim::millis() - ntpSyncedAt) < 0) {
+    if (sim::millis() - start >= ms) return false;
+    delay(10);
+  }
+  time_t now = sim::epoch();
+  gmtime_r(&now, info);
+  return true;
+}
+
+uint32_t EspClass::getCycleCount() {
+  auto elapsed = std::chrono::steady_clock::now() - sim::startTime;
+  return (uint32_t)(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() * getCpuFreqMHz() / 1000);
+}
+
+void EspClass::restart() {
+  Serial.println("[sim] ESP.restart() requested - exiting");
+  exit(0);
+}
@@ -0,0 +1,274 @@
+/*************************************************************
+********** NATIVE SIM - ARDUINO-ESP32 CORE STAND-IN **********
+**************************************************************/
+
+/*
+Just enough of the Arduino-ESP32 core for src/main.cpp to build on a Linux host:
+ - String (same heap behaviour as WString), Print, Stream and Serial (stdout)
+ - millis()/delay() on a simulated clock (see sim::)
+ - GPIO/LEDC calls as no-ops, buttons read as released
+ - configTime()/getLocalTime() backed by the simulated clock (NTP answers after a short delay)
+ - time() reads the simulated clock too (the native env links with -Wl,--wrap=time)
+ - FreeRTOS tasks/queues/semaphores (SimFreeRTOS.h) stepped in lockstep with the clock
+*/
+
+#pragma once
+
+#include <cctype>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <algorithm>
+#include <string>
+
+#include "SimFreeRTOS.h"
+
+using std::max;
+using std::min;
+
+#define HIGH 0x1
+#define LOW  0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define PROGMEM
+#define IRAM_ATTR
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// Simulated clock and run options shared by the stand-ins
+namespace sim {
+  extern bool deterministic; // fixed epoch and fixed frame step, for golden images
+  uint32_t millis();
+  uint64_t micros();
+  void advance(uint32_t ms); // move the simulated clock forward without sleeping
+  void sleepFor(uint32_t ms); // delay(): main thread advances the clock, tasks wait for it
+  time_t epoch();            // simulated wall clock (local time, no TZ applied)
+  void setEpoch(time_t t);
+}
+
+// String (Arduino-ESP32 WString storage: up to 9 characters inline, longer text on the heap
+// in 16 byte steps, so the host makes the same malloc/realloc calls as the device)
+class String {
+public:
+  String(const char* cstr = "") { if (cstr) assign(cstr, (unsigned int)strlen(cstr)); }
+  explicit String(const std::string& str) { assign(str.data(), (unsigned int)str.size()); }
+  String(const String& str) { assign(str.buffer(), str.len_); }
+  String(String&& str) noexcept { take(str); }
+  explicit String(char c) { assign(&c, 1); }
+  explicit String(unsigned char value, unsigned char base = 10) : String((unsigned long)value, base) {}
+  explicit String(int value, unsigned char base = 10) : String((long)value, base) {}
+  explicit String(unsigned int value, unsigned char base = 10) : String((unsigned long)value, base) {}
+  explicit String(long value, unsigned char base = 10);
+  explicit String(unsigned long value, unsigned char base = 10);
+  explicit String(float value, unsigned int decimalPlaces = 2) : String((double)value, decimalPlaces) {}
+  explicit String(double value, unsigned int decimalPlaces = 2);
+  ~String() { free(heap_); }
+
+  String& operator=(const String& str) { if (this != &str) assign(str.buffer(), str.len_); return *this; }
+  String& operator=(String&& str) noexcept { if (this != &str) { free(heap_); take(str); } return *this; }
+  String& operator=(const char* cstr) { if (cstr) assign(cstr, (unsigned int)strlen(cstr)); else assign("", 0); return *this; }
+
+  unsigned int length() const { return len_; }
+  const char* c_str() const { return buffer(); }
+  bool reserve(unsigned int size);
+
+  bool concat(const String& str) { return append(str.buffer(), str.len_); }
+  bool concat(const char* cstr) { return cstr && append(cstr, (unsigned int)strlen(cstr)); }
+  bool concat(const char* cstr, unsigned int len) { return cstr && append(cstr, len); }
+  bool concat(char c) { return append(&c, 1); }
+  bool concat(int num) { return concat(String(num)); }
+  bool concat(long num) { return concat(String(num)); }
+  bool concat(unsigned long num) { return concat(String(num)); }
+  bool concat(float num) { return concat(String(num)); }
+  bool concat(double num) { return concat(String(num)); }
+
+  template <typename T> String& operator+=(const T& rhs) { concat(rhs); return *this; }
+
+  char operator[](unsigned int index) const { return index < len_ ? buffer()[index] : 0; }
+  char& operator[](unsigned int index) { return buffer()[index]; }
+  char charAt(unsigned int index) const { return (*this)[index]; }
+  void setCharAt(unsigned int index, char c) { if (index < len_) buffer()[index] = c; }
+
+  bool equals(const String& str) const { return len_ == str.len_ && memcmp(buffer(), str.buffer(), len_) == 0; }
+  bool equals(const char* cstr) const { return strcmp(buffer(), cstr ? cstr : "") == 0; }
+  bool operator==(const String& rhs) const { return equals(rhs); }
+  bool operator==(const char* rhs) const { return equals(rhs); }
+  bool operator!=(const String& rhs) const { return !equals(rhs); }
+  bool operator!=(const char* rhs) const { return !equals(rhs); }
+  bool operator<(const String& rhs) const { return strcmp(buffer(), rhs.buffer()) < 0; }
+
+  bool startsWith(const String& prefix) const { return prefix.len_ <= len_ && memcmp(buffer(), prefix.buffer(), prefix.len_) == 0; }
+  bool endsWith(const String& suffix) const {
+    return suffix.len_ <= len_ && memcmp(buffer() + len_ - suffix.len_, suffix.buffer(), suffix.len_) == 0;
+  }
+  int indexOf(char c, unsigned int from = 0) const {
+    if (from >= len_) return -1;
+    const char* p = strchr(buffer() + from, c);
+    return p ? (int)(p - buffer()) : -1;
+  }
+  int indexOf(const String& str, unsigned int from = 0) const {
+    if (from > len_) return -1;
+    const char* p = strstr(buffer() + from, str.buffer());
+    return p ? (int)(p - buffer()) : -1;
+  }
+  String substring(unsigned int from) const { return substring(from, len_); }
+  String substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    String out;
+    if (from >= len_) return out;
+    out.assign(buffer() + from, std::min(to, len_) - from);
+    return out;
+  }
+  void toUpperCase() { for (unsigned int i = 0; i < len_; i++) buffer()[i] = (char)toupper((unsigned char)buffer()[i]); }
+  void toLowerCase() { for (unsigned int i = 0; i < len_; i++) buffer()[i] = (char)tolower((unsigned char)buffer()[i]); }
+  void trim();
+  long toInt() const { return atol(buffer()); }
+  float toFloat() const { return (float)atof(buffer()); }
+
+private:
+  static const unsigned int ssoChars = 9; // WString keeps 11 bytes inline, usable for 9 characters
+
+  char* buffer() { return heap_ ? heap_ : sso_; }
+  const char* buffer() const { return heap_ ? heap_ : sso_; }
+  bool assign(const char* data, unsigned int len);
+  bool append(const char* data, unsigned int len);
+  void take(String& str);
+
+  char sso_[ssoChars + 1] = {};
+  char* heap_ = nullptr;
+  unsigned int capacity_ = ssoChars;
+  unsigned int len_ = 0;
+};
+
+inline String operator+(const String& lhs, const String& rhs) { String r(lhs); r.concat(rhs); return r; }
+inline String operator+(const String& lhs, const char* rhs) { String r(lhs); r.concat(rhs); return r; }
+inline String operator+(const char* lhs, const String& rhs) { String r(lhs); r.concat(rhs); return r; }
+inline String operator+(const String& lhs, char rhs) { String r(lhs); r.concat(rhs); return r; }
+
+// Print / Printable / Stream
+class Print;
+
+class Printable {
+public:
+  virtual ~Printable() {}
+  virtual size_t printTo(Print& p) const = 0;
+};
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+  }
+  size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+
+  size_t print(const char* str) { return write(str); }
+  size_t print(const String& str) { return write(str.c_str()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int n) { return print(String(n)); }
+  size_t print(unsigned int n) { return print(String(n)); }
+  size_t print(long n) { return print(String(n)); }
+  size_t print(unsigned long n) { return print(String(n)); }
+  size_t print(double n, int digits = 2) { return print(String(n, digits)); }
+  size_t print(const Printable& x) { return x.printTo(*this); }
+
+  template <typename T> size_t println(const T& value) { size_t n = print(value); return n + println(); }
+  size_t println(double n, int digits) { size_t r = print(n, digits); return r + println(); }
+  size_t println() { return write("\r\n"); }
+
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+  virtual size_t readBytes(char* buffer, size_t length) {
+    size_t n = 0;
+    while (n < length) {
+      int c = read();
+      if (c < 0) break;
+      buffer[n++] = (char)c;
+    }
+    return n;
+  }
+  size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+  void setTimeout(unsigned long) {}
+};
+
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long) {}
+  void end() {}
+  void flush() { fflush(stdout); }
+  operator bool() const { return true; }
+  size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+  size_t write(const uint8_t* buffer, size_t size) override { return fwrite(buffer, 1, size, stdout); }
+  using Print::write;
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+};
+
+extern HardwareSerial Serial;
+
+// Timing
+inline unsigned long millis() { return sim::millis(); }
+inline unsigned long micros() { return (unsigned long)sim::micros(); }
+inline void delay(uint32_t ms) { sim::sleepFor(ms); }
+inline void delayMicroseconds(uint32_t) {}
+inline void yield() {}
+
+// GPIO / LEDC (no hardware on the host)
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return HIGH; } // buttons are active LOW, so released
+inline void analogWrite(uint8_t, int) {}
+inline uint32_t ledcSetup(uint8_t, uint32_t freq, uint8_t) { return freq; }
+inline void ledcAttachPin(uint8_t, uint8_t) {}
+inline void ledcWrite(uint8_t, uint32_t) {}
+
+// Maths helpers
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  const long run = in_max - in_min;
+  if (run == 0) return out_min; // same guard as the ESP32 core
+  return (x - in_min) * (out_max - out_min) / run + out_min;
+}
+
+char* dtostrf(double val, signed char width, unsigned char prec, char* sout);
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+size_t strlcpy(char* dst, const char* src, size_t size); // in newlib, only in newer glibc
+#endif
+
+// Time (esp32-hal-time)
+void configTime(long gmtOffset_sec, int daylightOffset_sec, const char* server1,
+                const char* server2 = nullptr, const char* server3 = nullptr);
+bool getLocalTime(struct tm* info, uint32_t ms = 5000);
+
+// ESP object
+class EspClass {
+public:
+  [[noreturn]] void restart();
+  uint32_t getFreeHeap() { return 320 * 1024; }
+  uint32_t getMaxAllocHeap() { return 192 * 1024; }
+  uint32_t getCpuFreqMHz() { return 240; }
+  uint32_t getCycleCount(); // host steady_clock at getCpuFreqMHz(), wraps like CCOUNT
+};
+
+extern EspClass ESP;
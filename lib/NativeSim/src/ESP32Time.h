@@ -0,0 +1,38 @@
+/*************************************************************
+************** NATIVE SIM - ESP32Time STAND-IN ***************
+**************************************************************/
+
+#pragma once
+
+#include "Arduino.h"
+
+class ESP32Time {
+public:
+  ESP32Time(unsigned long offset = 0) : offset_(offset) {}
+
+  void setTimeStruct(tm t) { sim::setEpoch(timegm(&t) - (time_t)offset_); }
+  void setTime(unsigned long epoch, int ms = 0) { (void)ms; sim::setEpoch((time_t)epoch); }
+
+  tm getTimeStruct() {
+    time_t now = sim::epoch() + (time_t)offset_;
+    tm t;
+    gmtime_r(&now, &t);
+    return t;
+  }
+
+  unsigned long getEpoch() { return (unsigned long)(sim::epoch() + (time_t)offset_); }
+  int getHour(bool mode = false) { tm t = getTimeStruct(); return mode ? t.tm_hour : (t.tm_hour % 12 == 0 ? 12 : t.tm_hour % 12); }
+  int getMinute() { return getTimeStruct().tm_min; }
+  int getSecond() { return getTimeStruct().tm_sec; }
+
+  // "HH:MM:SS"
+  String getTime() {
+    tm t = getTimeStruct();
+    char buf[9];
+    strftime(buf, sizeof(buf), "%H:%M:%S", &t);
+    return String(buf);
+  }
+
+private:
+  unsigned long offset_;
+};
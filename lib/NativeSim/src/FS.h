@@ -0,0 +1,40 @@
+/*************************************************************
+***************** NATIVE SIM - FS STAND-IN *******************
+**************************************************************/
+
+#pragma once
+
+#include "Arduino.h"
+
+#include <memory>
+#include <vector>
+
+namespace fs {
+  struct SimFile;
+
+  // Open file handle, a copy shares the same open file like the real fs::File
+  class File : public Stream {
+  public:
+    File() {}
+    explicit File(std::shared_ptr<SimFile> file) : file_(file) {}
+
+    explicit operator bool() const { return (bool)file_; }
+    size_t size() const;
+    size_t position() const;
+    bool seek(uint32_t pos);
+    void close();
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    size_t read(uint8_t* buffer, size_t size);
+    int available() override;
+    int read() override;
+    int peek() override;
+
+  private:
+    std::shared_ptr<SimFile> file_;
+  };
+}
+
+using fs::File;
@@ -0,0 +1,45 @@
+/*************************************************************
+************** NATIVE SIM - HTTPClient STAND-IN **************
+**************************************************************/
+
+/*
+Answers the two OpenWeatherMap endpoints the sketch uses with canned JSON:
+ - /geo/1.0/direct   -> fixed coordinates
+ - /data/2.5/weather -> a temperature that drifts with the simulated clock
+Anything else returns 404. Requests cost simulated time, and with setReuse(true) a
+caller-supplied client stays connected between requests like an HTTP/1.1 keep-alive.
+A request on a connection the server has dropped fails with HTTPC_ERROR_CONNECTION_LOST,
+and like the library the caller's client is left for the caller to stop().
+*/
+
+#pragma once
+
+#include "Arduino.h"
+#include "WiFi.h"
+
+#define HTTP_CODE_OK 200
+#define HTTP_CODE_NOT_FOUND 404
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+
+class HTTPClient {
+public:
+  bool begin(const String& url) { url_ = url; client_ = &ownClient_; return true; }
+  bool begin(WiFiClient& client, const String& url) { url_ = url; client_ = &client; return true; }
+  int GET();
+  String getString() { return body_; }
+  WiFiClient& getStream() { client_->load(body_); return *client_; }
+  WiFiClient* getStreamPtr() { return &getStream(); }
+  int getSize() { return (int)body_.length(); }
+  void useHTTP10(bool http10) { http10_ = http10; }
+  void setReuse(bool reuse) { reuse_ = reuse; }
+  void end();
+
+private:
+  String url_;
+  String body_;
+  WiFiClient ownClient_;
+  WiFiClient* client_ = &ownClient_;
+  bool http10_ = false;
+  bool reuse_ = true;
+};
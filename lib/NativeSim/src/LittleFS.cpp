@@ -0,0 +1,167 @@
+#include "LittleFS.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <map>
+#include <mutex>
+
+namespace sim {
+  const char* fsPath = nullptr;
+  uint64_t fsBytesWritten = 0;
+}
+
+fs::LittleFSFS LittleFS;
+
+namespace fs {
+  struct SimFile {
+    std::string name; // without the leading '/'
+    std::vector<uint8_t>* data;
+    size_t pos;
+    bool writable;
+  };
+}
+
+static std::map<std::string, std::vector<uint8_t>> files;
+static std::mutex filesMutex;
+static bool mounted = false;
+
+static std::string hostPath(const std::string& name) {
+  return std::string(sim::fsPath) + "/" + name;
+}
+
+static std::string fileName(const char* path) {
+  return path[0] == '/' ? path + 1 : path;
+}
+
+/*************************************************************
+************************ FILE SYSTEM *************************
+**************************************************************/
+
+bool fs::LittleFSFS::begin(bool, const char*, uint8_t, const char*) {
+  std::lock_guard<std::mutex> lock(filesMutex);
+  if (mounted) return true;
+  mounted = true;
+  if (!sim::fsPath) return true;
+
+  DIR* dir = opendir(sim::fsPath);
+  if (!dir) {
+    mkdir(sim::fsPath, 0755); // first run - files are written on close()
+    return true;
+  }
+  while (dirent* entry = readdir(dir)) {
+    if (entry->d_name[0] == '.') continue;
+    FILE* f = fopen(hostPath(entry->d_name).c_str(), "rb");
+    if (!f) continue;
+    std::vector<uint8_t>& data = files[entry->d_name];
+    uint8_t buf[4096];
+    for (size_t n; (n = fread(buf, 1, sizeof(buf), f)) > 0;) data.insert(data.end(), buf, buf + n);
+    fclose(f);
+  }
+  closedir(dir);
+  return true;
+}
+
+bool fs::LittleFSFS::format() {
+  std::lock_guard<std::mutex> lock(filesMutex);
+  for (const auto& file : files) {
+    if (sim::fsPath) ::remove(hostPath(file.first).c_str());
+  }
+  files.clear();
+  return true;
+}
+
+bool fs::LittleFSFS::exists(const char* path) {
+  std::lock_guard<std::mutex> lock(filesMutex);
+  return files.count(fileName(path)) > 0;
+}
+
+bool fs::LittleFSFS::remove(const char* path) {
+  std::lock_guard<std::mutex> lock(filesMutex);
+  std::string name = fileName(path);
+  if (!files.erase(name)) return false;
+  if (sim::fsPath) ::remove(hostPath(name).c_str());
+  return true;
+}
+
+fs::File fs::LittleFSFS::open(const char* path, const char* mode, bool) {
+  std::lock_guard<std::mutex> lock(filesMutex);
+  std::string name = fileName(path);
+  auto it = files.find(name);
+  if (mode[0] == 'r') {
+    if (it == files.end()) return File();
+    return File(std::make_shared<SimFile>(SimFile{ name, &it->second, 0, false }));
+  }
+
+  std::vector<uint8_t>& data = files[name];
+  if (mode[0] == 'w') data.clear();
+  return File(std::make_shared<SimFile>(SimFile{ name, &data, data.size(), true }));
+}
+
+size_t fs::LittleFSFS::usedBytes() {
+  std::lock_guard<std::mutex> lock(filesMutex);
+  size_t used = 0;
+  for (const auto& file : files) used += file.second.size();
+  return used;
+}
+
+/*************************************************************
+*************************** FILES ****************************
+**************************************************************/
+
+size_t fs::File::size() const {
+  return file_ ? file_->data->size() : 0;
+}
+
+size_t fs::File::position() const {
+  return file_ ? file_->pos : 0;
+}
+
+bool fs::File::seek(uint32_t pos) {
+  if (!file_ || pos > file_->data->size()) return false;
+  file_->pos = pos;
+  return true;
+}
+
+void fs::File::close() {
+  if (!file_) return;
+  if (file_->writable && sim::fsPath) {
+    std::lock_guard<std::mutex> lock(filesMutex);
+    FILE* f = fopen(hostPath(file_->name).c_str(), "wb");
+    if (f) {
+      fwrite(file_->data->data(), 1, file_->data->size(), f);
+      fclose(f);
+    }
+  }
+  file_.reset();
+}
+
+size_t fs::File::write(const uint8_t* buffer, size_t size) {
+  if (!file_ || !file_->writable) return 0;
+  std::vector<uint8_t>& data = *file_->data;
+  if (file_->pos + size > data.size()) data.resize(file_->pos + size);
+  memcpy(data.data() + file_->pos, buffer, size);
+  file_->pos += size;
+  sim::fsBytesWritten += size;
+  return size;
+}
+
+size_t fs::File::read(uint8_t* buffer, size_t size) {
+  if (!file_) return 0;
+  size_t n = std::min(size, file_->data->size() - file_->pos);
+  memcpy(buffer, file_->data->data() + file_->pos, n);
+  file_->pos += n;
+  return n;
+}
+
+int fs::File::available() {
+  return file_ ? (int)(file_->data->size() - file_->pos) : 0;
+}
+
+int fs::File::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+int fs::File::peek() {
+  return file_ && file_->pos < file_->data->size() ? (*file_->data)[file_->pos] : -1;
+}
@@ -0,0 +1,37 @@
+/*************************************************************
+*************** NATIVE SIM - LittleFS STAND-IN ***************
+**************************************************************/
+
+/*
+Flat file system kept in memory:
+ - open() supports "r", "w" (truncate) and "a" (append), files are flushed on close()
+ - with sim::fsPath set (--fs DIR) files are loaded from and written back to that host directory,
+   so consecutive runs see each other's files like reboots of the board
+ - bytesWritten counts everything written since start, to keep an eye on flash wear
+*/
+
+#pragma once
+
+#include "FS.h"
+
+namespace sim {
+  extern const char* fsPath;
+  extern uint64_t fsBytesWritten;
+}
+
+namespace fs {
+  class LittleFSFS {
+  public:
+    bool begin(bool formatOnFail = false, const char* basePath = "/littlefs", uint8_t maxOpenFiles = 10,
+               const char* partitionLabel = "spiffs");
+    void end() {}
+    bool format();
+    bool exists(const char* path);
+    bool remove(const char* path);
+    File open(const char* path, const char* mode = "r", bool create = false);
+    size_t totalBytes() { return 1408 * 1024; }
+    size_t usedBytes();
+  };
+}
+
+extern fs::LittleFSFS LittleFS;
@@ -0,0 +1,70 @@
+#include "HTTPClient.h"
+#include "WiFi.h"
+#include "WiFiClientSecure.h"
+
+WiFiClass WiFi;
+
+// Simulated network latency (delay() runs the clock, so fetches take time in the sim too)
+static const uint32_t tcpConnectMs = 60;
+static const uint32_t tlsHandshakeMs = 700;
+static const uint32_t requestMs = 150;
+
+int WiFiClient::connect(const char*, uint16_t) {
+  delay(tcpConnectMs);
+  open_ = true;
+  lastActivity_ = millis();
+  return 1;
+}
+
+int WiFiClientSecure::connect(const char* host, uint16_t port) {
+  WiFiClient::connect(host, port);
+  delay(tlsHandshakeMs);
+  return 1;
+}
+
+void HTTPClient::end() {
+  // HTTP/1.0 or setReuse(false) closes the connection after each response
+  if (http10_ || !reuse_ || client_ == &ownClient_) client_->stop();
+  url_ = "";
+  body_ = "";
+}
+
+// Canned OpenWeatherMap responses
+int HTTPClient::GET() {
+  // Connect on demand (a reused keep-alive connection skips this)
+  if (!client_->connected()) {
+    bool https = url_.startsWith("https://");
+    client_->connect("api.openweathermap.org", https ? 443 : 80);
+    if (https && client_ == &ownClient_) delay(tlsHandshakeMs); // the real HTTPClient makes its own secure client
+  }
+  delay(requestMs);
+  if (client_->dropped()) return HTTPC_ERROR_CONNECTION_LOST;
+
+  if (url_.indexOf("/geo/1.0/direct") >= 0) {
+    body_ = "[{\"name\":\"Cape Town\",\"local_names\":{\"en\":\"Cape Town\"},"
+            "\"lat\":-33.9288301,\"lon\":18.4172197,\"country\":\"ZA\"}]";
+    return HTTP_CODE_OK;
+  }
+
+  if (url_.indexOf("/data/2.5/weather") >= 0) {
+    // Slow diurnal swing so the history graph has something to show
+    double hours = (double)sim::epoch() / 3600.0;
+    double temp = 17.5 + 6.0 * sin(hours * 2.0 * M_PI / 24.0);
+    char buf[1024];
+    snprintf(buf, sizeof(buf),
+      "{\"coord\":{\"lon\":18.4172,\"lat\":-33.9288},"
+      "\"weather\":[{\"id\":802,\"main\":\"Clouds\",\"description\":\"scattered clouds\",\"icon\":\"03d\"}],"
+      "\"base\":\"stations\","
+      "\"main\":{\"temp\":%.2f,\"feels_like\":%.2f,\"temp_min\":%.2f,\"temp_max\":%.2f,"
+      "\"pressure\":1017,\"humidity\":72,\"sea_level\":1017,\"grnd_level\":1008},"
+      "\"visibility\":10000,\"wind\":{\"speed\":5.66,\"deg\":160},\"clouds\":{\"all\":40},"
+      "\"dt\":%ld,\"sys\":{\"type\":2,\"id\":2073005,\"country\":\"ZA\",\"sunrise\":1748756096,\"sunset\":1748792280},"
+      "\"timezone\":7200,\"id\":3369157,\"name\":\"Cape Town Airport\",\"cod\":200}",
+      temp, temp - 1.3, temp - 1.0, temp + 1.0, (long)sim::epoch());
+    body_ = buf;
+    return HTTP_CODE_OK;
+  }
+
+  body_ = "";
+  return HTTP_CODE_NOT_FOUND;
+}
@@ -0,0 +1,130 @@
+#include "Preferences.h"
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace sim {
+  const char* nvsPath = nullptr;
+}
+
+typedef std::map<std::string, std::vector<uint8_t>> NvsNamespace;
+static std::map<std::string, NvsNamespace> store;
+static std::mutex storeMutex;
+static bool loaded = false;
+
+/*
+File format, repeated per entry:
+  namespace\0 key\0 uint32 length, value bytes
+*/
+static void loadStore() {
+  loaded = true;
+  if (!sim::nvsPath) return;
+  FILE* f = fopen(sim::nvsPath, "rb");
+  if (!f) return;
+
+  auto readString = [f](std::string& out) {
+    out.clear();
+    for (int c; (c = fgetc(f)) > 0;) out += (char)c;
+    return !feof(f);
+  };
+  std::string ns, key;
+  uint32_t len;
+  while (readString(ns) && readString(key) && fread(&len, sizeof(len), 1, f) == 1) {
+    std::vector<uint8_t> value(len);
+    if (fread(value.data(), 1, len, f) != len) break;
+    store[ns][key] = value;
+  }
+  fclose(f);
+}
+
+static void saveStore() {
+  if (!sim::nvsPath) return;
+  FILE* f = fopen(sim::nvsPath, "wb");
+  if (!f) return;
+  for (const auto& ns : store) {
+    for (const auto& entry : ns.second) {
+      uint32_t len = (uint32_t)entry.second.size();
+      fwrite(ns.first.c_str(), 1, ns.first.size() + 1, f);
+      fwrite(entry.first.c_str(), 1, entry.first.size() + 1, f);
+      fwrite(&len, sizeof(len), 1, f);
+      fwrite(entry.second.data(), 1, len, f);
+    }
+  }
+  fclose(f);
+}
+
+bool Preferences::begin(const char* name, bool readOnly) {
+  std::lock_guard<std::mutex> lock(storeMutex);
+  if (!loaded) loadStore();
+  name_ = name;
+  readOnly_ = readOnly;
+  open_ = true;
+  return true;
+}
+
+void Preferences::end() {
+  std::lock_guard<std::mutex> lock(storeMutex);
+  if (open_ && !readOnly_) saveStore();
+  open_ = false;
+}
+
+bool Preferences::clear() {
+  std::lock_guard<std::mutex> lock(storeMutex);
+  if (!open_ || readOnly_) return false;
+  store[name_].clear();
+  return true;
+}
+
+bool Preferences::remove(const char* key) {
+  std::lock_guard<std::mutex> lock(storeMutex);
+  if (!open_ || readOnly_) return false;
+  return store[name_].erase(key) > 0;
+}
+
+bool Preferences::isKey(const char* key) {
+  std::lock_guard<std::mutex> lock(storeMutex);
+  return open_ && store[name_].count(key) > 0;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t len) {
+  std::lock_guard<std::mutex> lock(storeMutex);
+  if (!open_ || readOnly_ || strlen(key) > 15) return 0; // NVS keys are at most 15 characters
+  const uint8_t* bytes = (const uint8_t*)value;
+  store[name_][key].assign(bytes, bytes + len);
+  return len;
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+  std::lock_guard<std::mutex> lock(storeMutex);
+  if (!open_) return 0;
+  auto it = store[name_].find(key);
+  return it == store[name_].end() ? 0 : it->second.size();
+}
+
+size_t Preferences::getBytes(const char* key, void* buf, size_t maxLen) {
+  std::lock_guard<std::mutex> lock(storeMutex);
+  if (!open_) return 0;
+  auto it = store[name_].find(key);
+  if (it == store[name_].end() || it->second.size() > maxLen) return 0;
+  memcpy(buf, it->second.data(), it->second.size());
+  return it->second.size();
+}
+
+float Preferences::getFloat(const char* key, float defaultValue) {
+  float value;
+  return getBytesLength(key) == sizeof(value) && getBytes(key, &value, sizeof(value)) ? value : defaultValue;
+}
+
+uint32_t Preferences::getUInt(const char* key, uint32_t defaultValue) {
+  uint32_t value;
+  return getBytesLength(key) == sizeof(value) && getBytes(key, &value, sizeof(value)) ? value : defaultValue;
+}
+
+String Preferences::getString(const char* key, const String& defaultValue) {
+  size_t len = getBytesLength(key);
+  if (len == 0 && !isKey(key)) return defaultValue;
+  std::vector<char> buf(len + 1, '\0');
+  getBytes(key, buf.data(), len);
+  return String(buf.data());
+}
@@ -0,0 +1,44 @@
+/*************************************************************
+************* NATIVE SIM - Preferences STAND-IN **************
+**************************************************************/
+
+/*
+NVS key/value store kept in memory:
+ - values are stored as raw bytes per namespace/key, like the real blob storage
+ - with sim::nvsPath set (--nvs FILE) the store is loaded on first use and saved on end(),
+   so consecutive runs see each other's data like reboots of the board
+*/
+
+#pragma once
+
+#include "Arduino.h"
+
+namespace sim {
+  extern const char* nvsPath;
+}
+
+class Preferences {
+public:
+  bool begin(const char* name, bool readOnly = false);
+  void end();
+
+  bool clear();
+  bool remove(const char* key);
+  bool isKey(const char* key);
+
+  size_t putFloat(const char* key, float value) { return putBytes(key, &value, sizeof(value)); }
+  size_t putUInt(const char* key, uint32_t value) { return putBytes(key, &value, sizeof(value)); }
+  size_t putString(const char* key, const String& value) { return putBytes(key, value.c_str(), value.length()); }
+  size_t putBytes(const char* key, const void* value, size_t len);
+
+  float getFloat(const char* key, float defaultValue = NAN);
+  uint32_t getUInt(const char* key, uint32_t defaultValue = 0);
+  String getString(const char* key, const String& defaultValue = String());
+  size_t getBytesLength(const char* key);
+  size_t getBytes(const char* key, void* buf, size_t maxLen);
+
+private:
+  std::string name_;
+  bool open_ = false;
+  bool readOnly_ = false;
+};
@@ -0,0 +1,152 @@
+#include "Arduino.h"
+
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct SimTask {
+  TaskFunction_t fn;
+  void* param;
+  std::thread::id thread;
+};
+
+struct SimQueue {
+  std::mutex mutex;
+  UBaseType_t length;
+  UBaseType_t itemSize;
+  std::deque<std::vector<uint8_t>> items;
+};
+
+/*************************************************************
+*************************** TASKS ****************************
+**************************************************************/
+
+static SimTask loopTask = { nullptr, nullptr, std::this_thread::get_id() };
+static thread_local SimTask* currentTask = &loopTask;
+
+static void taskTrampoline(void* arg) {
+  SimTask* task = (SimTask*)arg;
+  task->thread = std::this_thread::get_id();
+  currentTask = task;
+  task->fn(task->param);
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char*, uint32_t, void* param,
+                                   UBaseType_t, TaskHandle_t* handle, BaseType_t) {
+  SimTask* task = new SimTask{ fn, param, std::thread::id() };
+  if (handle) *handle = task;
+  sim::startTask(taskTrampoline, task);
+  return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stackDepth, void* param,
+                       UBaseType_t priority, TaskHandle_t* handle) {
+  return xTaskCreatePinnedToCore(fn, name, stackDepth, param, priority, handle, tskNO_AFFINITY);
+}
+
+void vTaskDelay(TickType_t ticks) {
+  sim::sleepFor(ticks * portTICK_PERIOD_MS);
+}
+
+TickType_t xTaskGetTickCount() {
+  return (TickType_t)(sim::millis() / portTICK_PERIOD_MS);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+  return currentTask;
+}
+
+BaseType_t xPortGetCoreID() {
+  return currentTask == &loopTask ? 1 : 0;
+}
+
+/*************************************************************
+*************************** QUEUES ***************************
+**************************************************************/
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+  SimQueue* queue = new SimQueue;
+  queue->length = length;
+  queue->itemSize = itemSize;
+  return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+  delete queue;
+}
+
+// Retry a non-blocking attempt once per tick until it succeeds or the wait runs out
+template <typename Attempt>
+static BaseType_t waitFor(TickType_t ticksToWait, Attempt attempt) {
+  for (TickType_t waited = 0;; waited++) {
+    if (attempt()) return pdTRUE;
+    if (waited >= ticksToWait) return pdFALSE;
+    vTaskDelay(1);
+  }
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait) {
+  return waitFor(ticksToWait, [&] {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (queue->items.size() >= queue->length) return false;
+    const uint8_t* bytes = (const uint8_t*)item;
+    queue->items.emplace_back(bytes, bytes + queue->itemSize);
+    return true;
+  });
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void* item) {
+  std::lock_guard<std::mutex> lock(queue->mutex);
+  const uint8_t* bytes = (const uint8_t*)item;
+  queue->items.clear();
+  queue->items.emplace_back(bytes, bytes + queue->itemSize);
+  return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* buffer, TickType_t ticksToWait) {
+  return waitFor(ticksToWait, [&] {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (queue->items.empty()) return false;
+    if (queue->itemSize) memcpy(buffer, queue->items.front().data(), queue->itemSize);
+    queue->items.pop_front();
+    return true;
+  });
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void* buffer, TickType_t ticksToWait) {
+  return waitFor(ticksToWait, [&] {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (queue->items.empty()) return false;
+    if (queue->itemSize) memcpy(buffer, queue->items.front().data(), queue->itemSize);
+    return true;
+  });
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+  std::lock_guard<std::mutex> lock(queue->mutex);
+  return (UBaseType_t)queue->items.size();
+}
+
+/*************************************************************
+************************* SEMAPHORES *************************
+**************************************************************/
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+  return xQueueCreate(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+  SemaphoreHandle_t sem = xQueueCreate(1, 0);
+  xSemaphoreGive(sem);
+  return sem;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+  return xQueueSend(sem, nullptr, 0);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticksToWait) {
+  return xQueueReceive(sem, nullptr, ticksToWait);
+}
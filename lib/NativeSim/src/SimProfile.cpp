@@ -0,0 +1,54 @@
+#include "SimProfile.h"
+
+#include <cstring>
+
+namespace sim {
+  uint64_t busPixels = 0;
+
+  static ProfileEntry* entries = nullptr;
+  static thread_local int depth = 0; // per thread, the frame push task draws to the panel too
+
+  ProfileEntry::ProfileEntry(const char* entryName) : name(entryName), next(entries) {
+    entries = this;
+  }
+
+  ProfileScope::ProfileScope(ProfileEntry& entry) : entry_(depth == 0 ? &entry : nullptr) {
+    depth++;
+    if (entry_) start_ = std::chrono::steady_clock::now();
+  }
+
+  ProfileScope::~ProfileScope() {
+    depth--;
+    if (!entry_) return;
+    entry_->calls++;
+    entry_->nanos += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+  }
+
+  void profileReset() {
+    for (ProfileEntry* e = entries; e; e = e->next) e->calls = e->nanos = 0;
+  }
+
+  void profileReport(FILE* out, uint32_t frames) {
+    if (frames == 0) frames = 1;
+    fprintf(out, "%-22s %10s %12s %10s %12s\n", "primitive", "calls", "total ms", "ns/call", "calls/frame");
+
+    // Entries sharing a name (overloads) are folded into one line
+    for (ProfileEntry* e = entries; e; e = e->next) {
+      bool seen = false;
+      for (ProfileEntry* p = entries; p != e; p = p->next) {
+        if (strcmp(p->name, e->name) == 0) { seen = true; break; }
+      }
+      if (seen) continue;
+
+      uint64_t calls = 0, nanos = 0;
+      for (ProfileEntry* p = e; p; p = p->next) {
+        if (strcmp(p->name, e->name) == 0) { calls += p->calls; nanos += p->nanos; }
+      }
+      if (calls == 0) continue;
+      fprintf(out, "%-22s %10llu %12.3f %10llu %12.2f\n", e->name, (unsigned long long)calls, nanos / 1e6,
+              (unsigned long long)(nanos / calls), (double)calls / frames);
+    }
+    fprintf(out, "panel pixels written: %llu (%.0f per frame, %.1f KB/frame at 16 bpp)\n",
+            (unsigned long long)busPixels, (double)busPixels / frames, busPixels * 2.0 / frames / 1024.0);
+  }
+}
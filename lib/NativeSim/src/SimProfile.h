@@ -0,0 +1,44 @@
+/*************************************************************
+**************** NATIVE SIM - PRIMITIVE PROFILER *************
+**************************************************************/
+
+/*
+Per-primitive call counters and wall time for the TFT_eSPI stand-in.
+Only the outermost primitive is recorded, so fillRoundRect() calling
+fillRect() internally shows up once, as fillRoundRect().
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace sim {
+  struct ProfileEntry {
+    explicit ProfileEntry(const char* entryName);
+    const char* name;
+    uint64_t calls = 0;
+    uint64_t nanos = 0;
+    ProfileEntry* next = nullptr;
+  };
+
+  class ProfileScope {
+  public:
+    explicit ProfileScope(ProfileEntry& entry);
+    ~ProfileScope();
+
+  private:
+    ProfileEntry* entry_; // null when nested inside another primitive
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  extern uint64_t busPixels; // pixels written to the panel (pushSprite/pushImage/fillScreen...)
+
+  void profileReset();
+  void profileReport(FILE* out, uint32_t frames);
+}
+
+#define SIM_PROFILE(label) \
+  static sim::ProfileEntry simProfileEntry_(label); \
+  sim::ProfileScope simProfileScope_(simProfileEntry_)
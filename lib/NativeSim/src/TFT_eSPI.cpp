@@ -0,0 +1,564 @@
+#include "TFT_eSPI.h"
+#include "SimProfile.h"
+
+TFT_eSPI* sim::panel = nullptr;
+
+static inline uint16_t swap16(uint16_t c) { return (uint16_t)((c >> 8) | (c << 8)); }
+
+/*************************************************************
+*************************** PANEL ****************************
+**************************************************************/
+
+TFT_eSPI::TFT_eSPI(int16_t w, int16_t h) : init_width_(w), init_height_(h) {
+  _width = w;
+  _height = h;
+  panel_ = (uint16_t*)calloc((size_t)w * h, sizeof(uint16_t));
+  if (sim::panel == nullptr) sim::panel = this;
+}
+
+TFT_eSPI::~TFT_eSPI() {
+  unloadFont();
+  free(panel_);
+}
+
+void TFT_eSPI::init(uint8_t) {
+  setRotation(0);
+  fillScreen(TFT_BLACK);
+}
+
+void TFT_eSPI::setRotation(uint8_t r) {
+  rotation_ = r & 3;
+  bool landscape = rotation_ & 1;
+  _width = landscape ? init_height_ : init_width_;
+  _height = landscape ? init_width_ : init_height_;
+}
+
+void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color) {
+  if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+  panel_[y * _width + x] = (uint16_t)color;
+  sim::busPixels++;
+}
+
+uint16_t TFT_eSPI::readPixel(int32_t x, int32_t y) {
+  if (x < 0 || y < 0 || x >= _width || y >= _height) return 0;
+  return panel_[y * _width + x];
+}
+
+void TFT_eSPI::setAddrWindow(int32_t x, int32_t y, int32_t w, int32_t h) {
+  winX_ = x; winY_ = y; winW_ = w; winH_ = h; winPos_ = 0;
+}
+
+void TFT_eSPI::pushPixels(const void* data_in, uint32_t len) {
+  const uint16_t* data = (const uint16_t*)data_in;
+  while (len-- && winW_ > 0 && winPos_ < winW_ * winH_) {
+    uint16_t c = swapBytes_ ? *data : swap16(*data);
+    TFT_eSPI::drawPixel(winX_ + winPos_ % winW_, winY_ + winPos_ / winW_, c);
+    data++;
+    winPos_++;
+  }
+}
+
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data) {
+  SIM_PROFILE("pushImage");
+  setAddrWindow(x, y, w, h);
+  pushPixels(data, (uint32_t)(w * h));
+}
+
+/*************************************************************
+************************* PRIMITIVES *************************
+**************************************************************/
+
+void TFT_eSPI::fillRectRaw(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > _width) w = _width - x;
+  if (y + h > _height) h = _height - y;
+  for (int32_t j = y; j < y + h; j++) {
+    for (int32_t i = x; i < x + w; i++) drawPixel(i, j, color);
+  }
+}
+
+void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  SIM_PROFILE("fillRect");
+  fillRectRaw(x, y, w, h, color);
+}
+
+void TFT_eSPI::fillScreen(uint32_t color) {
+  SIM_PROFILE("fillScreen");
+  fillRect(0, 0, _width, _height, color);
+}
+
+void TFT_eSPI::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+void TFT_eSPI::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+void TFT_eSPI::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
+  SIM_PROFILE("drawLine");
+  int32_t dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+  int32_t dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+  int32_t err = dx + dy;
+  while (true) {
+    drawPixel(x0, y0, color);
+    if (x0 == x1 && y0 == y1) break;
+    int32_t e2 = 2 * err;
+    if (e2 >= dy) { err += dy; x0 += sx; }
+    if (e2 <= dx) { err += dx; y0 += sy; }
+  }
+}
+
+void TFT_eSPI::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  SIM_PROFILE("drawRect");
+  fillRectRaw(x, y, w, 1, color);
+  fillRectRaw(x, y + h - 1, w, 1, color);
+  fillRectRaw(x, y, 1, h, color);
+  fillRectRaw(x + w - 1, y, 1, h, color);
+}
+
+void TFT_eSPI::fillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color) {
+  SIM_PROFILE("fillCircle");
+  for (int32_t dy = -r; dy <= r; dy++) {
+    int32_t dx = (int32_t)sqrtf((float)(r * r - dy * dy) + 0.5f);
+    fillRectRaw(x0 - dx, y0 + dy, 2 * dx + 1, 1, color);
+  }
+}
+
+void TFT_eSPI::fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color) {
+  SIM_PROFILE("fillRoundRect");
+  for (int32_t j = 0; j < h; j++) {
+    int32_t inset = 0;
+    int32_t dy = j < r ? r - j : (j >= h - r ? j - (h - r - 1) : 0);
+    if (dy > 0) inset = r - (int32_t)sqrtf((float)(r * r - dy * dy) + 0.5f);
+    fillRectRaw(x + inset, y + j, w - 2 * inset, 1, color);
+  }
+}
+
+void TFT_eSPI::fillSmoothRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t radius, uint32_t color, uint32_t bg_color) {
+  SIM_PROFILE("fillSmoothRoundRect");
+  if (radius > w / 2) radius = w / 2;
+  if (radius > h / 2) radius = h / 2;
+  const float rr = (float)radius;
+  for (int32_t j = 0; j < h; j++) {
+    for (int32_t i = 0; i < w; i++) {
+      // Distance from the nearest corner centre, only inside the corner squares
+      float cx = i < radius ? rr - 0.5f : (i >= w - radius ? (float)(w - radius) - 0.5f : (float)i);
+      float cy = j < radius ? rr - 0.5f : (j >= h - radius ? (float)(h - radius) - 0.5f : (float)j);
+      float dist = sqrtf((i - cx) * (i - cx) + (j - cy) * (j - cy));
+      float cover = rr + 0.5f - dist;
+      if (cover >= 1.0f) {
+        drawPixel(x + i, y + j, color);
+      } else if (cover > 0.0f) {
+        uint16_t bg = bg_color == 0x00FFFFFF ? readPixel(x + i, y + j) : (uint16_t)bg_color;
+        drawPixel(x + i, y + j, alphaBlend((uint8_t)(cover * 255.0f), (uint16_t)color, bg));
+      }
+    }
+  }
+}
+
+uint16_t TFT_eSPI::alphaBlend(uint8_t alpha, uint16_t fgc, uint16_t bgc) {
+  // Same 6 bit green / 5 bit red+blue blend as the library
+  uint16_t fgR = ((fgc >> 10) & 0x3E) + 1;
+  uint16_t fgG = ((fgc >> 4) & 0x7E) + 1;
+  uint16_t fgB = ((fgc << 1) & 0x3E) + 1;
+  uint16_t bgR = ((bgc >> 10) & 0x3E) + 1;
+  uint16_t bgG = ((bgc >> 4) & 0x7E) + 1;
+  uint16_t bgB = ((bgc << 1) & 0x3E) + 1;
+  uint16_t r = (((fgR * alpha) + (bgR * (255 - alpha))) >> 9);
+  uint16_t g = (((fgG * alpha) + (bgG * (255 - alpha))) >> 9);
+  uint16_t b = (((fgB * alpha) + (bgB * (255 - alpha))) >> 9);
+  return (uint16_t)((r << 11) | (g << 5) | (b << 0));
+}
+
+/*************************************************************
+**************************** TEXT ****************************
+**************************************************************/
+
+// GLCD stand-in: a stable 5x7 pattern per character code, 6x8 cell
+void TFT_eSPI::drawGlcdChar(int32_t x, int32_t y, uint8_t c) {
+  const int32_t s = textsize_;
+  if (textbgcolor_ != textcolor_) fillRectRaw(x, y, 6 * s, 8 * s, textbgcolor_);
+  if (c == ' ') return;
+  uint32_t h = c * 2654435761u;
+  for (int32_t col = 0; col < 5; col++) {
+    uint8_t bits = (uint8_t)((h >> (col * 5)) | 0x41) & 0x7F; // top and bottom rows set so cells stay visible
+    for (int32_t row = 0; row < 7; row++) {
+      if (bits & (1 << row)) fillRectRaw(x + col * s, y + row * s, s, s, textcolor_);
+    }
+  }
+}
+
+uint32_t TFT_eSPI::readInt32() {
+  const uint8_t* p = gFont.gArray + fontPtr_;
+  fontPtr_ += 4;
+  return ((uint32_t)pgm_read_byte(p) << 24) | ((uint32_t)pgm_read_byte(p + 1) << 16) |
+         ((uint32_t)pgm_read_byte(p + 2) << 8) | (uint32_t)pgm_read_byte(p + 3);
+}
+
+void TFT_eSPI::loadFont(const uint8_t array[]) {
+  SIM_PROFILE("loadFont");
+  if (fontLoaded) unloadFont();
+  if (array == nullptr) return;
+
+  gFont.gArray = array;
+  fontPtr_ = 0;
+  gFont.gCount = (uint16_t)readInt32();
+  readInt32(); // encoder version
+  gFont.yAdvance = (uint16_t)readInt32();
+  readInt32(); // unused
+  gFont.ascent = (int16_t)readInt32();
+  gFont.descent = (int16_t)readInt32();
+  gFont.maxAscent = gFont.ascent;
+  gFont.maxDescent = gFont.descent;
+  gFont.yAdvance = gFont.ascent + gFont.descent;
+  gFont.spaceWidth = gFont.yAdvance / 4;
+
+  // Glyph metrics, one heap array per field as in Smooth_font.cpp
+  uint32_t bitmapPtr = 24 + (uint32_t)gFont.gCount * 28;
+  gUnicode = (uint16_t*)malloc(gFont.gCount * 2);
+  gHeight = (uint8_t*)malloc(gFont.gCount);
+  gWidth = (uint8_t*)malloc(gFont.gCount);
+  gxAdvance = (uint8_t*)malloc(gFont.gCount);
+  gdY = (int16_t*)malloc(gFont.gCount * 2);
+  gdX = (int8_t*)malloc(gFont.gCount);
+  gBitmap = (uint32_t*)malloc(gFont.gCount * 4);
+
+  for (uint16_t gNum = 0; gNum < gFont.gCount; gNum++) {
+    gUnicode[gNum] = (uint16_t)readInt32();
+    gHeight[gNum] = (uint8_t)readInt32();
+    gWidth[gNum] = (uint8_t)readInt32();
+    gxAdvance[gNum] = (uint8_t)readInt32();
+    gdY[gNum] = (int16_t)readInt32();
+    gdX[gNum] = (int8_t)readInt32();
+    readInt32(); // padding
+
+    bool printable = (gUnicode[gNum] > 0x20 && gUnicode[gNum] < 0x7F) || gUnicode[gNum] > 0xA0;
+    if (printable && gdY[gNum] > (int16_t)gFont.maxAscent) gFont.maxAscent = gdY[gNum];
+    if (printable && (int16_t)gHeight[gNum] - gdY[gNum] > (int16_t)gFont.maxDescent) gFont.maxDescent = gHeight[gNum] - gdY[gNum];
+    if (gUnicode[gNum] == ' ') gFont.spaceWidth = gxAdvance[gNum];
+
+    gBitmap[gNum] = bitmapPtr;
+    bitmapPtr += (uint32_t)gWidth[gNum] * gHeight[gNum];
+  }
+
+  gFont.yAdvance = gFont.maxAscent + gFont.maxDescent;
+  fontLoaded = true;
+}
+
+void TFT_eSPI::unloadFont() {
+  SIM_PROFILE("unloadFont");
+  free(gUnicode); gUnicode = nullptr;
+  free(gHeight); gHeight = nullptr;
+  free(gWidth); gWidth = nullptr;
+  free(gxAdvance); gxAdvance = nullptr;
+  free(gdY); gdY = nullptr;
+  free(gdX); gdX = nullptr;
+  free(gBitmap); gBitmap = nullptr;
+  gFont.gArray = nullptr;
+  fontLoaded = false;
+}
+
+bool TFT_eSPI::getUnicodeIndex(uint16_t unicode, uint16_t* index) {
+  for (uint16_t i = 0; i < gFont.gCount; i++) {
+    if (gUnicode[i] == unicode) {
+      *index = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+void TFT_eSPI::drawGlyph(uint16_t code) {
+  if (code < 0x21) {
+    if (code == 0x20) cursor_x_ += gFont.spaceWidth;
+    if (code == '\n') { cursor_x_ = 0; cursor_y_ += gFont.yAdvance; }
+    return;
+  }
+
+  uint16_t gNum = 0;
+  if (!getUnicodeIndex(code, &gNum)) {
+    // Missing glyph: outline box like the library
+    drawRect(cursor_x_, cursor_y_ + gFont.maxAscent - gFont.ascent, gFont.spaceWidth, gFont.ascent, textcolor_);
+    cursor_x_ += gFont.spaceWidth + 1;
+    return;
+  }
+
+  const int32_t y0 = cursor_y_ + gFont.maxAscent - gdY[gNum];
+  const int32_t x0 = cursor_x_ + gdX[gNum];
+  const uint8_t* bitmap = gFont.gArray + gBitmap[gNum];
+  for (int32_t row = 0; row < gHeight[gNum]; row++) {
+    for (int32_t col = 0; col < gWidth[gNum]; col++) {
+      uint8_t alpha = pgm_read_byte(bitmap + row * gWidth[gNum] + col);
+      if (alpha == 0) continue;
+      if (alpha == 0xFF) {
+        drawPixel(x0 + col, y0 + row, textcolor_);
+      } else {
+        uint16_t bg = textcolor_ == textbgcolor_ ? readPixel(x0 + col, y0 + row) : textbgcolor_;
+        drawPixel(x0 + col, y0 + row, alphaBlend(alpha, textcolor_, bg));
+      }
+    }
+  }
+  cursor_x_ += gxAdvance[gNum];
+}
+
+int16_t TFT_eSPI::textWidth(const char* string) {
+  if (string == nullptr) return 0;
+  int32_t width = 0;
+  if (fontLoaded) {
+    for (const char* p = string; *p; p++) {
+      uint16_t gNum = 0;
+      if (*p == ' ') width += gFont.spaceWidth;
+      else if (getUnicodeIndex((uint8_t)*p, &gNum)) {
+        // Like the library: a negative bearing on the first glyph widens the string,
+        // and the last glyph counts to the right edge of its ink rather than its advance
+        if (width == 0 && gdX[gNum] < 0) width -= gdX[gNum];
+        width += p[1] ? gxAdvance[gNum] : gdX[gNum] + gWidth[gNum];
+      }
+      else width += gFont.spaceWidth + 1;
+    }
+  } else {
+    width = (int32_t)strlen(string) * 6 * textsize_;
+  }
+  return (int16_t)width;
+}
+
+int16_t TFT_eSPI::fontHeight() {
+  return fontLoaded ? gFont.yAdvance : 8 * textsize_;
+}
+
+int16_t TFT_eSPI::drawString(const char* string, int32_t x, int32_t y, uint8_t font) {
+  uint8_t previous = textfont_;
+  textfont_ = font;
+  int16_t width = drawString(string, x, y);
+  textfont_ = previous;
+  return width;
+}
+
+int16_t TFT_eSPI::drawString(const char* string, int32_t x, int32_t y) {
+  SIM_PROFILE("drawString");
+  if (string == nullptr) return 0;
+
+  const int32_t cwidth = textWidth(string);
+  const int32_t cheight = fontHeight();
+  const int32_t baseline = fontLoaded ? gFont.maxAscent : 7 * textsize_;
+
+  switch (textdatum_) {
+    case TC_DATUM: x -= cwidth / 2; break;
+    case TR_DATUM: x -= cwidth; break;
+    case ML_DATUM: y -= cheight / 2; break;
+    case MC_DATUM: x -= cwidth / 2; y -= cheight / 2; break;
+    case MR_DATUM: x -= cwidth; y -= cheight / 2; break;
+    case BL_DATUM: y -= cheight; break;
+    case BC_DATUM: x -= cwidth / 2; y -= cheight; break;
+    case BR_DATUM: x -= cwidth; y -= cheight; break;
+    case L_BASELINE: y -= baseline; break;
+    case C_BASELINE: x -= cwidth / 2; y -= baseline; break;
+    case R_BASELINE: x -= cwidth; y -= baseline; break;
+    default: break;
+  }
+
+  if (fontLoaded) {
+    cursor_x_ = x;
+    cursor_y_ = y;
+    for (const char* p = string; *p; p++) drawGlyph((uint8_t)*p);
+  } else {
+    for (const char* p = string; *p; p++) {
+      drawGlcdChar(x, y, (uint8_t)*p);
+      x += 6 * textsize_;
+    }
+  }
+  return (int16_t)cwidth;
+}
+
+int16_t TFT_eSPI::drawNumber(long intNumber, int32_t x, int32_t y) {
+  char buf[16];
+  snprintf(buf, sizeof(buf), "%ld", intNumber);
+  return drawString(buf, x, y);
+}
+
+int16_t TFT_eSPI::drawFloat(float floatNumber, uint8_t decimal, int32_t x, int32_t y) {
+  SIM_PROFILE("drawFloat");
+  char buf[24];
+  snprintf(buf, sizeof(buf), "%.*f", decimal > 7 ? 7 : decimal, floatNumber);
+  return drawString(buf, x, y);
+}
+
+size_t TFT_eSPI::write(uint8_t c) {
+  if (c == '\r') return 1;
+  if (fontLoaded) {
+    drawGlyph(c);
+    return 1;
+  }
+  if (c == '\n') {
+    cursor_x_ = 0;
+    cursor_y_ += 8 * textsize_;
+    return 1;
+  }
+  drawGlcdChar(cursor_x_, cursor_y_, c);
+  cursor_x_ += 6 * textsize_;
+  return 1;
+}
+
+/*************************************************************
+************************** SPRITES ***************************
+**************************************************************/
+
+TFT_eSprite::TFT_eSprite(TFT_eSPI* tft) : TFT_eSPI(SpriteTag{}), tft_(tft) {
+  _width = 0;
+  _height = 0;
+}
+
+TFT_eSprite::~TFT_eSprite() {
+  deleteSprite();
+}
+
+void* TFT_eSprite::createSprite(int16_t w, int16_t h, uint8_t) {
+  if (img_) return img_;
+  _width = w;
+  _height = h;
+  iwidth_ = bpp_ == 4 ? (w + 1) & ~1 : w;
+  size_t bytes = bpp_ == 16 ? (size_t)iwidth_ * h * 2 : bpp_ == 8 ? (size_t)iwidth_ * h : (size_t)iwidth_ * h / 2;
+  img_ = (uint8_t*)calloc(bytes, 1);
+  if (bpp_ == 4 && colorMap_[1] == 0) createPalette();
+  return img_;
+}
+
+void TFT_eSprite::deleteSprite() {
+  free(img_);
+  img_ = nullptr;
+}
+
+void* TFT_eSprite::setColorDepth(int8_t b) {
+  bool wasCreated = created();
+  int16_t w = width(), h = height();
+  deleteSprite();
+  bpp_ = (b == 8 || b == 4) ? b : 16;
+  return wasCreated ? createSprite(w, h) : nullptr;
+}
+
+void TFT_eSprite::createPalette(const uint16_t* palette, uint8_t colors) {
+  // Library default palette when none is given
+  static const uint16_t defaultPalette[16] = {
+    TFT_BLACK, 0x8000, TFT_RED, 0xFD20, TFT_YELLOW, TFT_GREEN, TFT_BLUE, 0x915C,
+    TFT_DARKGREY, TFT_WHITE, 0x07FF, 0xF81F, 0x7800, TFT_DARKGREEN, TFT_NAVY, TFT_LIGHTGREY
+  };
+  if (palette == nullptr) palette = defaultPalette, colors = 16;
+  for (uint8_t i = 0; i < 16; i++) colorMap_[i] = i < colors ? palette[i] : 0;
+}
+
+void TFT_eSprite::drawPixel(int32_t x, int32_t y, uint32_t color) {
+  if (!img_ || x < 0 || y < 0 || x >= _width || y >= _height) return;
+  if (bpp_ == 16) {
+    ((uint16_t*)img_)[x + y * iwidth_] = swap16((uint16_t)color);
+  } else if (bpp_ == 8) {
+    img_[x + y * iwidth_] = (uint8_t)(((color & 0xE000) >> 8) | ((color & 0x0700) >> 6) | ((color & 0x0018) >> 3));
+  } else {
+    uint8_t c = color & 0x0F;
+    int32_t index = (x + y * iwidth_) >> 1;
+    if ((x & 1) == 0) img_[index] = (uint8_t)((c << 4) | (img_[index] & 0x0F));
+    else img_[index] = (uint8_t)(c | (img_[index] & 0xF0));
+  }
+}
+
+uint16_t TFT_eSprite::readPixelValue(int32_t x, int32_t y) {
+  if (!img_ || x < 0 || y < 0 || x >= _width || y >= _height) return 0xFFFF;
+  if (bpp_ == 16) return swap16(((uint16_t*)img_)[x + y * iwidth_]);
+  if (bpp_ == 8) return img_[x + y * iwidth_];
+  uint8_t b = img_[(x + y * iwidth_) >> 1];
+  return (x & 1) ? (b & 0x0F) : (b >> 4);
+}
+
+uint16_t TFT_eSprite::readPixel(int32_t x, int32_t y) {
+  uint16_t value = readPixelValue(x, y);
+  if (bpp_ == 16) return value;
+  if (bpp_ == 4) return colorMap_[value & 0x0F];
+  // RGB332 -> RGB565
+  uint16_t r = (value & 0xE0) >> 5, g = (value & 0x1C) >> 2, b = value & 0x03;
+  return (uint16_t)(((r * 31 / 7) << 11) | ((g * 63 / 7) << 5) | (b * 31 / 3));
+}
+
+void TFT_eSprite::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  SIM_PROFILE("fillRect");
+  if (!img_) return;
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > _width) w = _width - x;
+  if (y + h > _height) h = _height - y;
+  if (w <= 0 || h <= 0) return;
+  if (bpp_ == 16) {
+    uint16_t c = swap16((uint16_t)color);
+    for (int32_t j = y; j < y + h; j++) {
+      uint16_t* row = (uint16_t*)img_ + j * iwidth_ + x;
+      for (int32_t i = 0; i < w; i++) row[i] = c;
+    }
+  } else {
+    for (int32_t j = y; j < y + h; j++) {
+      for (int32_t i = x; i < x + w; i++) drawPixel(i, j, color);
+    }
+  }
+}
+
+void TFT_eSprite::fillSprite(uint32_t color) {
+  SIM_PROFILE("fillSprite");
+  fillRect(0, 0, _width, _height, color);
+}
+
+// 16 bpp rows are copied as stored (sprite byte order, swapped when setSwapBytes(true)), other depths convert
+void TFT_eSprite::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data) {
+  SIM_PROFILE("pushImage");
+  if (!img_) return;
+  for (int32_t j = 0; j < h; j++) {
+    if (y + j < 0 || y + j >= _height) continue;
+    for (int32_t i = 0; i < w; i++) {
+      if (x + i < 0 || x + i >= _width) continue;
+      uint16_t c = data[i + j * w];
+      if (bpp_ == 16) {
+        ((uint16_t*)img_)[x + i + (y + j) * iwidth_] = swapBytes_ ? swap16(c) : c;
+      } else {
+        drawPixel(x + i, y + j, swapBytes_ ? swap16(c) : c);
+      }
+    }
+  }
+}
+
+void TFT_eSprite::pushSprite(int32_t x, int32_t y) {
+  SIM_PROFILE("pushSprite");
+  pushSprite(x, y, 0, 0, _width, _height);
+}
+
+bool TFT_eSprite::pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh) {
+  SIM_PROFILE("pushSprite");
+  if (!img_ || !tft_) return false;
+  if (sx < 0) { sw += sx; tx -= sx; sx = 0; }
+  if (sy < 0) { sh += sy; ty -= sy; sy = 0; }
+  if (sx + sw > _width) sw = _width - sx;
+  if (sy + sh > _height) sh = _height - sy;
+  if (sw <= 0 || sh <= 0) return false;
+  for (int32_t j = 0; j < sh; j++) {
+    for (int32_t i = 0; i < sw; i++) tft_->drawPixel(tx + i, ty + j, readPixel(sx + i, sy + j));
+  }
+  return true;
+}
+
+bool TFT_eSprite::pushToSprite(TFT_eSprite* dspr, int32_t x, int32_t y) {
+  SIM_PROFILE("pushToSprite");
+  if (!img_ || !dspr) return false;
+  for (int32_t j = 0; j < _height; j++) {
+    for (int32_t i = 0; i < _width; i++) dspr->drawPixel(x + i, y + j, readPixel(i, j));
+  }
+  return true;
+}
+
+bool TFT_eSprite::pushToSprite(TFT_eSprite* dspr, int32_t x, int32_t y, uint16_t transparent) {
+  SIM_PROFILE("pushToSprite");
+  if (!img_ || !dspr) return false;
+  for (int32_t j = 0; j < _height; j++) {
+    for (int32_t i = 0; i < _width; i++) {
+      uint16_t c = readPixel(i, j);
+      if (c != transparent) dspr->drawPixel(x + i, y + j, c);
+    }
+  }
+  return true;
+}
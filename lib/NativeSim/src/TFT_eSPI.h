@@ -0,0 +1,217 @@
+/*************************************************************
+*************** NATIVE SIM - TFT_eSPI STAND-IN ***************
+**************************************************************/
+
+/*
+Software TFT_eSPI/TFT_eSprite with the same public surface the sketch uses:
+ - TFT_eSPI renders into an in-memory RGB565 panel (320x170 after setRotation(1))
+ - TFT_eSprite keeps its pixels in the same layout as the real library
+   (16 bpp byte-swapped, 8 bpp RGB332, 4 bpp palette indices two per byte)
+ - Smooth (VLW) fonts are parsed and alpha-blended like Smooth_font.cpp
+ - The built-in GLCD font is drawn as placeholder 5x7 cells (no font table)
+Every primitive is counted by SimProfile so per-call costs can be compared.
+*/
+
+#pragma once
+
+#include "Arduino.h"
+
+#define TFT_WIDTH  170
+#define TFT_HEIGHT 320
+#define TFT_BL     38
+
+// Colours
+#define TFT_BLACK       0x0000
+#define TFT_NAVY        0x000F
+#define TFT_DARKGREEN   0x03E0
+#define TFT_MAROON      0x7800
+#define TFT_DARKGREY    0x7BEF
+#define TFT_LIGHTGREY   0xD69A
+#define TFT_BLUE        0x001F
+#define TFT_GREEN       0x07E0
+#define TFT_RED         0xF800
+#define TFT_YELLOW      0xFFE0
+#define TFT_WHITE       0xFFFF
+
+// Text datums
+#define TL_DATUM 0
+#define TC_DATUM 1
+#define TR_DATUM 2
+#define ML_DATUM 3
+#define MC_DATUM 4
+#define MR_DATUM 5
+#define BL_DATUM 6
+#define BC_DATUM 7
+#define BR_DATUM 8
+#define L_BASELINE 9
+#define C_BASELINE 10
+#define R_BASELINE 11
+
+class TFT_eSPI : public Print {
+public:
+  // Smooth font metrics, nested in the class like the library's
+  typedef struct {
+    const uint8_t* gArray;
+    uint16_t gCount;
+    uint16_t yAdvance;
+    uint16_t spaceWidth;
+    int16_t ascent;
+    int16_t descent;
+    uint16_t maxAscent;
+    uint16_t maxDescent;
+  } fontMetrics;
+
+  TFT_eSPI(int16_t w = TFT_WIDTH, int16_t h = TFT_HEIGHT);
+  virtual ~TFT_eSPI();
+
+  void init(uint8_t tc = 0);
+  void begin(uint8_t tc = 0) { init(tc); }
+  void setRotation(uint8_t r);
+  uint8_t getRotation() const { return rotation_; }
+  int16_t width() const { return (int16_t)_width; }
+  int16_t height() const { return (int16_t)_height; }
+
+  // Pixel access (overridden by sprites)
+  virtual void drawPixel(int32_t x, int32_t y, uint32_t color);
+  virtual uint16_t readPixel(int32_t x, int32_t y);
+
+  // Graphics primitives
+  virtual void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void fillScreen(uint32_t color);
+  virtual void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color);
+  virtual void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color);
+  void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color);
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void fillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color);
+  void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t radius, uint32_t color);
+  void fillSmoothRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t radius, uint32_t color, uint32_t bg_color = 0x00FFFFFF);
+
+  // Text
+  void setTextDatum(uint8_t datum) { textdatum_ = datum; }
+  uint8_t getTextDatum() const { return textdatum_; }
+  void setTextColor(uint16_t color) { textcolor_ = textbgcolor_ = color; }
+  void setTextColor(uint16_t fgcolor, uint16_t bgcolor, bool bgfill = false) { (void)bgfill; textcolor_ = fgcolor; textbgcolor_ = bgcolor; }
+  void setTextSize(uint8_t size) { textsize_ = size ? size : 1; }
+  void setTextFont(uint8_t font) { textfont_ = font; }
+  void setCursor(int16_t x, int16_t y) { cursor_x_ = x; cursor_y_ = y; }
+  int16_t getCursorX() const { return (int16_t)cursor_x_; }
+  int16_t getCursorY() const { return (int16_t)cursor_y_; }
+
+  int16_t drawString(const char* string, int32_t x, int32_t y);
+  int16_t drawString(const char* string, int32_t x, int32_t y, uint8_t font);
+  int16_t drawString(const String& string, int32_t x, int32_t y) { return drawString(string.c_str(), x, y); }
+  int16_t drawString(const String& string, int32_t x, int32_t y, uint8_t font) { return drawString(string.c_str(), x, y, font); }
+  int16_t drawNumber(long intNumber, int32_t x, int32_t y);
+  int16_t drawFloat(float floatNumber, uint8_t decimal, int32_t x, int32_t y);
+  int16_t textWidth(const char* string);
+  int16_t textWidth(const String& string) { return textWidth(string.c_str()); }
+  int16_t fontHeight();
+
+  // Smooth fonts
+  void loadFont(const uint8_t array[]);
+  void unloadFont();
+  bool getUnicodeIndex(uint16_t unicode, uint16_t* index);
+  virtual void drawGlyph(uint16_t code);
+
+  // Colour helpers
+  uint16_t color565(uint8_t red, uint8_t green, uint8_t blue) {
+    return ((red & 0xF8) << 8) | ((green & 0xFC) << 3) | (blue >> 3);
+  }
+  uint16_t alphaBlend(uint8_t alpha, uint16_t fgc, uint16_t bgc);
+
+  // Low level panel writes
+  void startWrite() {}
+  void endWrite() {}
+  void setSwapBytes(bool swap) { swapBytes_ = swap; }
+  bool getSwapBytes() const { return swapBytes_; }
+  void setAddrWindow(int32_t x, int32_t y, int32_t w, int32_t h);
+  void pushPixels(const void* data_in, uint32_t len);
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data);
+
+  // Print
+  size_t write(uint8_t c) override;
+  using Print::write;
+
+  // Smooth font state - public as in the real library
+  fontMetrics gFont = { nullptr, 0, 0, 0, 0, 0, 0, 0 };
+  uint16_t* gUnicode = nullptr;
+  uint8_t* gHeight = nullptr;
+  uint8_t* gWidth = nullptr;
+  uint8_t* gxAdvance = nullptr;
+  int16_t* gdY = nullptr;
+  int8_t* gdX = nullptr;
+  uint32_t* gBitmap = nullptr;
+  bool fontLoaded = false;
+
+  // Simulation access to the panel contents (host order RGB565, width() x height())
+  const uint16_t* simPanel() const { return panel_; }
+
+protected:
+  struct SpriteTag {};
+  explicit TFT_eSPI(SpriteTag) : panel_(nullptr) {}
+
+  void fillRectRaw(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void drawGlcdChar(int32_t x, int32_t y, uint8_t c);
+  uint32_t readInt32();
+
+  int32_t _width = TFT_HEIGHT;
+  int32_t _height = TFT_WIDTH;
+  int32_t init_width_ = TFT_WIDTH;
+  int32_t init_height_ = TFT_HEIGHT;
+  uint8_t rotation_ = 0;
+
+  int32_t cursor_x_ = 0;
+  int32_t cursor_y_ = 0;
+  uint16_t textcolor_ = TFT_WHITE;
+  uint16_t textbgcolor_ = TFT_WHITE;
+  uint8_t textsize_ = 1;
+  uint8_t textfont_ = 1;
+  uint8_t textdatum_ = TL_DATUM;
+  uint32_t fontPtr_ = 0;
+
+  bool swapBytes_ = false;
+  int32_t winX_ = 0, winY_ = 0, winW_ = 0, winH_ = 0, winPos_ = 0;
+
+  uint16_t* panel_;
+};
+
+class TFT_eSprite : public TFT_eSPI {
+public:
+  explicit TFT_eSprite(TFT_eSPI* tft);
+  ~TFT_eSprite() override;
+
+  void* createSprite(int16_t w, int16_t h, uint8_t frames = 1);
+  void deleteSprite();
+  bool created() const { return img_ != nullptr; }
+  void* getPointer() { return img_; }
+  void* setColorDepth(int8_t b);
+  int8_t getColorDepth() const { return bpp_; }
+  void setPsram(bool) {}
+
+  void createPalette(const uint16_t* palette = nullptr, uint8_t colors = 16);
+  void setPaletteColor(uint8_t index, uint16_t color) { if (index < 16) colorMap_[index] = color; }
+  uint16_t getPaletteColor(uint8_t index) const { return index < 16 ? colorMap_[index] : 0; }
+
+  void drawPixel(int32_t x, int32_t y, uint32_t color) override;
+  uint16_t readPixel(int32_t x, int32_t y) override;
+  uint16_t readPixelValue(int32_t x, int32_t y);
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) override;
+  void fillSprite(uint32_t color);
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data);
+
+  void pushSprite(int32_t x, int32_t y);
+  bool pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh);
+  bool pushToSprite(TFT_eSprite* dspr, int32_t x, int32_t y);
+  bool pushToSprite(TFT_eSprite* dspr, int32_t x, int32_t y, uint16_t transparent);
+
+private:
+  TFT_eSPI* tft_;
+  uint8_t* img_ = nullptr; // raw storage, layout depends on bpp_
+  int8_t bpp_ = 16;
+  int32_t iwidth_ = 0;     // storage width (even for 4 bpp)
+  uint16_t colorMap_[16] = {};
+};
+
+namespace sim {
+  extern TFT_eSPI* panel; // first TFT_eSPI constructed - the one sim_main dumps
+}
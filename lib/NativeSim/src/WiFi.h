@@ -0,0 +1,75 @@
+/*************************************************************
+**************** NATIVE SIM - WiFi STAND-IN ******************
+**************************************************************/
+
+#pragma once
+
+#include "Arduino.h"
+
+class IPAddress : public Printable {
+public:
+  IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : bytes_{ a, b, c, d } {}
+
+  String toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", bytes_[0], bytes_[1], bytes_[2], bytes_[3]);
+    return String(buf);
+  }
+
+  size_t printTo(Print& p) const override { return p.print(toString()); }
+
+private:
+  uint8_t bytes_[4];
+};
+
+/*
+Connection stand-in:
+ - connect() costs simulated time (a TLS handshake for WiFiClientSecure)
+ - the "server" drops connections left idle longer than keepAliveMs, the client only notices when
+   the next request on it fails (connected() stays true until then, like a half-closed socket)
+ - the response body HTTPClient loads into it is replayed through Stream
+*/
+class WiFiClient : public Stream {
+public:
+  static const unsigned long keepAliveMs = 60000;
+
+  virtual ~WiFiClient() {}
+  virtual int connect(const char* host, uint16_t port);
+  uint8_t connected() { return open_; }
+  bool dropped() const { return open_ && millis() - lastActivity_ > keepAliveMs; } // sim only
+  void stop() { open_ = false; data_.clear(); pos_ = 0; }
+
+  int available() override { return (int)(data_.size() - pos_); }
+  int read() override { return pos_ < data_.size() ? (uint8_t)data_[pos_++] : -1; }
+  int peek() override { return pos_ < data_.size() ? (uint8_t)data_[pos_] : -1; }
+  size_t write(uint8_t) override { return 1; }
+  size_t write(const uint8_t*, size_t size) override { return size; }
+
+  void load(const String& body) { data_ = body.c_str(); pos_ = 0; lastActivity_ = millis(); } // sim only
+
+protected:
+  bool open_ = false;
+  unsigned long lastActivity_ = 0;
+
+private:
+  std::string data_;
+  size_t pos_ = 0;
+};
+
+typedef enum {
+  WL_IDLE_STATUS = 0,
+  WL_CONNECTED = 3,
+  WL_DISCONNECTED = 6
+} wl_status_t;
+
+// Always-connected station with a fixed signal level
+class WiFiClass {
+public:
+  wl_status_t status() { return WL_CONNECTED; }
+  bool isConnected() { return true; }
+  String SSID() { return String("sim-network"); }
+  IPAddress localIP() { return IPAddress(192, 168, 1, 50); }
+  int8_t RSSI() { return -61; }
+};
+
+extern WiFiClass WiFi;
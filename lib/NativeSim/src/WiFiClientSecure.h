@@ -0,0 +1,15 @@
+/*************************************************************
+*********** NATIVE SIM - WiFiClientSecure STAND-IN ***********
+**************************************************************/
+
+#pragma once
+
+#include "WiFi.h"
+
+// TLS client: connect() includes the handshake time, certificates are not checked
+class WiFiClientSecure : public WiFiClient {
+public:
+  void setInsecure() {}
+  void setCACert(const char*) {}
+  int connect(const char* host, uint16_t port) override;
+};
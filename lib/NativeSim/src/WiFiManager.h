@@ -0,0 +1,18 @@
+/*************************************************************
+************** NATIVE SIM - WiFiManager STAND-IN *************
+**************************************************************/
+
+#pragma once
+
+#include "Arduino.h"
+
+// The simulated station always connects (after associating/DHCP), so the portal never opens
+class WiFiManager {
+public:
+  static const uint32_t connectMs = 1200;
+
+  void setConfigPortalTimeout(unsigned long) {}
+  void setConnectTimeout(unsigned long) {}
+  bool autoConnect(const char*, const char* = nullptr) { delay(connectMs); return true; }
+  bool startConfigPortal(const char*, const char* = nullptr) { return true; }
+};
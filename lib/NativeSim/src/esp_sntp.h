@@ -0,0 +1,13 @@
+/*************************************************************
+**************** NATIVE SIM - esp_sntp STAND-IN **************
+**************************************************************/
+
+#pragma once
+
+#include "Arduino.h"
+
+#include <sys/time.h>
+
+// Called from a background task once configTime() has "synchronised" (see Arduino.cpp)
+typedef void (*sntp_sync_time_cb_t)(struct timeval* tv);
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback);
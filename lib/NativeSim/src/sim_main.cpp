@@ -0,0 +1,132 @@
+/*************************************************************
+******************** NATIVE SIM - ENTRY POINT ****************
+**************************************************************/
+
+/*
+Runs the sketch on the host:
+  .pio/build/native/program [--frames N] [--deterministic] [--frame-ms N]
+                            [--dump out.ppm] [--golden ref.ppm] [--nvs store.bin] [--fs DIR]
+
+ --frames N        number of loop() iterations (default 600)
+ --deterministic   fixed start time and a fixed --frame-ms step per loop(),
+                   so the final frame is reproducible for golden images
+ --dump FILE       write the final panel contents as a binary PPM
+ --golden FILE     compare the final panel against a PPM; exit code 1 on mismatch
+ --nvs FILE        keep Preferences (NVS) in FILE so the next run boots like a restart
+ --fs DIR          keep LittleFS files in DIR (created if missing), same idea as --nvs
+
+After the run a per-primitive cost table (SimProfile) is printed to stderr.
+*/
+
+#include "Arduino.h"
+#include "TFT_eSPI.h"
+#include "Preferences.h"
+#include "LittleFS.h"
+#include "SimProfile.h"
+
+#include <chrono>
+#include <vector>
+
+void setup();
+void loop();
+
+// Panel contents as 8 bit RGB
+static std::vector<uint8_t> panelToRgb(const TFT_eSPI& panel) {
+  std::vector<uint8_t> rgb;
+  const uint16_t* px = panel.simPanel();
+  const int32_t count = (int32_t)panel.width() * panel.height();
+  rgb.reserve((size_t)count * 3);
+  for (int32_t i = 0; i < count; i++) {
+    uint16_t c = px[i];
+    rgb.push_back((uint8_t)(((c >> 11) & 0x1F) * 255 / 31));
+    rgb.push_back((uint8_t)(((c >> 5) & 0x3F) * 255 / 63));
+    rgb.push_back((uint8_t)((c & 0x1F) * 255 / 31));
+  }
+  return rgb;
+}
+
+static bool writePpm(const char* path, const TFT_eSPI& panel) {
+  FILE* f = fopen(path, "wb");
+  if (!f) return false;
+  std::vector<uint8_t> rgb = panelToRgb(panel);
+  fprintf(f, "P6\n%d %d\n255\n", panel.width(), panel.height());
+  fwrite(rgb.data(), 1, rgb.size(), f);
+  fclose(f);
+  return true;
+}
+
+// Returns the number of differing pixels, or -1 if the file can't be used
+static long comparePpm(const char* path, const TFT_eSPI& panel) {
+  FILE* f = fopen(path, "rb");
+  if (!f) return -1;
+  int w = 0, h = 0, maxval = 0;
+  if (fscanf(f, "P6 %d %d %d", &w, &h, &maxval) != 3 || w != panel.width() || h != panel.height() || maxval != 255) {
+    fclose(f);
+    return -1;
+  }
+  fgetc(f); // single whitespace after the header
+  std::vector<uint8_t> golden((size_t)w * h * 3);
+  size_t got = fread(golden.data(), 1, golden.size(), f);
+  fclose(f);
+  if (got != golden.size()) return -1;
+
+  std::vector<uint8_t> rgb = panelToRgb(panel);
+  long diff = 0;
+  for (size_t i = 0; i < rgb.size(); i += 3) {
+    if (rgb[i] != golden[i] || rgb[i + 1] != golden[i + 1] || rgb[i + 2] != golden[i + 2]) diff++;
+  }
+  return diff;
+}
+
+int main(int argc, char** argv) {
+  uint32_t frames = 600;
+  uint32_t frameMs = 33;
+  const char* dumpPath = nullptr;
+  const char* goldenPath = nullptr;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--frames") && i + 1 < argc) frames = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(argv[i], "--frame-ms") && i + 1 < argc) frameMs = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(argv[i], "--deterministic")) sim::deterministic = true;
+    else if (!strcmp(argv[i], "--dump") && i + 1 < argc) dumpPath = argv[++i];
+    else if (!strcmp(argv[i], "--golden") && i + 1 < argc) goldenPath = argv[++i];
+    else if (!strcmp(argv[i], "--nvs") && i + 1 < argc) sim::nvsPath = argv[++i];
+    else if (!strcmp(argv[i], "--fs") && i + 1 < argc) sim::fsPath = argv[++i];
+    else {
+      fprintf(stderr, "usage: %s [--frames N] [--deterministic] [--frame-ms N] [--dump out.ppm] [--golden ref.ppm] [--nvs store.bin] [--fs DIR]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  setup();
+
+  // Only the frame loop is profiled, setup() costs are not per-frame
+  sim::busPixels = 0;
+  sim::profileReset();
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < frames; i++) {
+    loop();
+    if (sim::deterministic) sim::advance(frameMs);
+  }
+  double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  fprintf(stderr, "\n%u frames in %.1f ms host time (%.1f us/frame)\n", frames, wallMs, frames ? wallMs * 1000.0 / frames : 0.0);
+  sim::profileReport(stderr, frames);
+  if (sim::fsBytesWritten) fprintf(stderr, "flash file writes: %llu bytes\n", (unsigned long long)sim::fsBytesWritten);
+
+  if (dumpPath && !writePpm(dumpPath, *sim::panel)) {
+    fprintf(stderr, "could not write %s\n", dumpPath);
+    return 2;
+  }
+
+  if (goldenPath) {
+    long diff = comparePpm(goldenPath, *sim::panel);
+    if (diff < 0) {
+      fprintf(stderr, "golden: could not read %s\n", goldenPath);
+      return 2;
+    }
+    fprintf(stderr, "golden: %ld pixels differ\n", diff);
+    return diff == 0 ? 0 : 1;
+  }
+  return 0;
+}
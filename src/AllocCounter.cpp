@@ -0,0 +1,26 @@
+#include "AllocCounter.h"
+
+TaskHandle_t AllocCounter::watched = NULL;
+volatile uint32_t AllocCounter::allocations = 0;
+
+// Linker wrappers (-Wl,--wrap=malloc etc. in platformio.ini): String, new and the Arduino core all end up here
+extern "C" {
+  void* __real_malloc(size_t size);
+  void* __real_calloc(size_t count, size_t size);
+  void* __real_realloc(void* ptr, size_t size);
+
+  void* IRAM_ATTR __wrap_malloc(size_t size) {
+    AllocCounter::record();
+    return __real_malloc(size);
+  }
+
+  void* IRAM_ATTR __wrap_calloc(size_t count, size_t size) {
+    AllocCounter::record();
+    return __real_calloc(count, size);
+  }
+
+  void* IRAM_ATTR __wrap_realloc(void* ptr, size_t size) {
+    AllocCounter::record();
+    return __real_realloc(ptr, size);
+  }
+}
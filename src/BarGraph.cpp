@@ -0,0 +1,39 @@
+#include "BarGraph.h"
+
+// Render the column strip (in the target's pixel format, so it is drawn with the sprite primitives)
+bool BarGraph::begin(const GraphGeometry& graph, uint8_t columnCount, uint8_t levelCount, uint16_t colour, uint16_t background) {
+  geometry = graph;
+  columns = columnCount < maxColumns ? columnCount : maxColumns;
+  levels = levelCount;
+  columnHeight = levels * geometry.blockPitch - (geometry.blockPitch - geometry.blockHeight);
+  drawn = false;
+
+  // Rows [0, levels * pitch) are background, the blocks start below them
+  int16_t blocksTop = levels * geometry.blockPitch;
+  if (!strip.createSprite(geometry.blockWidth, blocksTop + columnHeight)) return false;
+  strip.fillSprite(background);
+  for (uint8_t i = 0; i < levels; i++) {
+    strip.fillRect(0, blocksTop + i * geometry.blockPitch, geometry.blockWidth, geometry.blockHeight, colour);
+  }
+  return true;
+}
+
+bool BarGraph::changed(const uint8_t* bars) const {
+  return !drawn || memcmp(bars, drawnBars, columns) != 0;
+}
+
+// Paint every column: the window for a bar of n blocks starts n pitches down the strip
+void BarGraph::draw(GreySprite& target, const uint8_t* bars) {
+  if (!strip.created()) return;
+  const uint8_t* pixels = strip.pixels();
+  int16_t top = geometry.baseline - (levels - 1) * geometry.blockPitch;
+
+  for (uint8_t j = 0; j < columns; j++) {
+    uint8_t blocks = bars[j] < levels ? bars[j] : levels;
+    const uint8_t* window = pixels + blocks * geometry.blockPitch * geometry.blockWidth;
+    target.blit(geometry.x + j * geometry.columnPitch, top, geometry.blockWidth, columnHeight, window, geometry.blockWidth);
+  }
+
+  memcpy(drawnBars, bars, columns);
+  drawn = true;
+}
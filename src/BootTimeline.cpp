@@ -0,0 +1,18 @@
+#include "BootTimeline.h"
+
+static const char* const phaseNames[BootTimeline::PHASE_COUNT] = { "first frame", "wifi", "time", "location", "weather" };
+
+void BootTimeline::mark(Phase phase, unsigned long now) {
+  if (done(phase)) return;
+  times[phase] = now; // published by the fetch_or below, done() readers see it once the bit is set
+  doneMask.fetch_or((uint8_t)(1 << phase));
+}
+
+void BootTimeline::report(Print& out) const {
+  out.print("Boot:");
+  for (uint8_t i = 0; i < PHASE_COUNT; i++) {
+    if (done((Phase)i)) out.printf(" %s %lums", phaseNames[i], times[i]);
+    else out.printf(" %s -", phaseNames[i]);
+  }
+  out.println();
+}
@@ -0,0 +1,80 @@
+#include "DirtyRegions.h"
+
+// Rectangles that overlap or share an edge can be pushed as one window
+bool DirtyRegions::touches(const Rect& a, const Rect& b) {
+  return a.x <= b.x + b.w && b.x <= a.x + a.w && a.y <= b.y + b.h && b.y <= a.y + a.h;
+}
+
+Rect DirtyRegions::merged(const Rect& a, const Rect& b) {
+  int16_t x0 = min(a.x, b.x);
+  int16_t y0 = min(a.y, b.y);
+  int16_t x1 = max(a.x + a.w, b.x + b.w);
+  int16_t y1 = max(a.y + a.h, b.y + b.h);
+  return { x0, y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0) };
+}
+
+// Mark a rectangle as changed (clipped to the sprite)
+void DirtyRegions::add(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > width) w = width - x;
+  if (y + h > height) h = height - y;
+  if (w <= 0 || h <= 0) return;
+
+  Rect r = { x, y, w, h };
+
+  // Absorb every existing rectangle the new one touches (repeat, since growing can touch more)
+  bool grew = true;
+  while (grew) {
+    grew = false;
+    for (uint8_t i = 0; i < count; i++) {
+      if (touches(rects[i], r)) {
+        r = merged(rects[i], r);
+        rects[i] = rects[--count];
+        grew = true;
+        break;
+      }
+    }
+  }
+
+  if (count == maxRects) mergeCheapestPair();
+  rects[count++] = r;
+}
+
+// Combine the two rectangles whose bounding box wastes the fewest pixels
+void DirtyRegions::mergeCheapestPair() {
+  uint8_t bestA = 0, bestB = 1;
+  int32_t bestCost = INT32_MAX;
+  for (uint8_t a = 0; a < count; a++) {
+    for (uint8_t b = a + 1; b < count; b++) {
+      Rect m = merged(rects[a], rects[b]);
+      int32_t cost = (int32_t)m.w * m.h - (int32_t)rects[a].w * rects[a].h - (int32_t)rects[b].w * rects[b].h;
+      if (cost < bestCost) {
+        bestCost = cost;
+        bestA = a;
+        bestB = b;
+      }
+    }
+  }
+  rects[bestA] = merged(rects[bestA], rects[bestB]);
+  rects[bestB] = rects[--count];
+}
+
+uint32_t DirtyRegions::area() const {
+  uint32_t total = 0;
+  for (uint8_t i = 0; i < count; i++) total += (uint32_t)rects[i].w * rects[i].h;
+  return total;
+}
+
+uint8_t DirtyRegions::take(Rect* out) {
+  uint8_t taken = count;
+  if (area() * 100 >= (uint32_t)width * height * fullPushPercent) {
+    // Mostly dirty - one full transfer beats many window setups
+    out[0] = { 0, 0, width, height };
+    taken = 1;
+  } else {
+    for (uint8_t i = 0; i < count; i++) out[i] = rects[i];
+  }
+  count = 0;
+  return taken;
+}
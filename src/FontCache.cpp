@@ -0,0 +1,50 @@
+#include "FontCache.h"
+
+// Parse a VLW array once and take ownership of its metric tables
+FontCache::Handle FontCache::add(TFT_eSPI& tft, const uint8_t* vlwArray) {
+  if (count >= maxFonts) return count - 1; // full - reuse the last font rather than leak
+
+  tft.loadFont(vlwArray);
+
+  Entry& entry = entries[count];
+  entry.metrics = tft.gFont;
+  entry.unicode = tft.gUnicode;
+  entry.height = tft.gHeight;
+  entry.width = tft.gWidth;
+  entry.xAdvance = tft.gxAdvance;
+  entry.dY = tft.gdY;
+  entry.dX = tft.gdX;
+  entry.bitmap = tft.gBitmap;
+
+  // Detach the tables so the sprite no longer owns (or frees) them
+  release(tft);
+
+  return count++;
+}
+
+// Make a cached font the active smooth font of a sprite (no parsing, no allocation)
+void FontCache::select(TFT_eSPI& tft, Handle font) const {
+  const Entry& entry = entries[font];
+  tft.gFont = entry.metrics;
+  tft.gUnicode = entry.unicode;
+  tft.gHeight = entry.height;
+  tft.gWidth = entry.width;
+  tft.gxAdvance = entry.xAdvance;
+  tft.gdY = entry.dY;
+  tft.gdX = entry.dX;
+  tft.gBitmap = entry.bitmap;
+  tft.fontLoaded = true;
+}
+
+// Back to the built-in font without freeing the cached tables
+void FontCache::release(TFT_eSPI& tft) const {
+  tft.gUnicode = nullptr;
+  tft.gHeight = nullptr;
+  tft.gWidth = nullptr;
+  tft.gxAdvance = nullptr;
+  tft.gdY = nullptr;
+  tft.gdX = nullptr;
+  tft.gBitmap = nullptr;
+  tft.gFont.gArray = nullptr;
+  tft.fontLoaded = false;
+}
@@ -0,0 +1,50 @@
+#include "FrameGovernor.h"
+
+FrameGovernor::FrameGovernor(uint8_t clockFps, uint8_t scrollingFps, uint16_t inputPollMs)
+  : targets{ clockFps, scrollingFps }, inputPollMs(inputPollMs) {}
+
+// Switch content class, a faster class starts on the next loop rather than after the old period
+void FrameGovernor::setContent(Content newContent) {
+  if (newContent == content) return;
+  if (targets[newContent] > targets[content]) frameRequested = true;
+  content = newContent;
+}
+
+bool FrameGovernor::frameDue(unsigned long now) const {
+  if (frameRequested) return true;
+  if (targets[content] == 0) return false;
+  return (long)(now - nextFrame) >= 0;
+}
+
+void FrameGovernor::frameDone(unsigned long now) {
+  frameRequested = false;
+
+  // Advance by whole periods so the rate doesn't drift, resync if we fell behind by more than one
+  uint8_t fps = targets[content];
+  if (fps > 0) {
+    unsigned long period = 1000 / fps;
+    nextFrame += period;
+    if ((long)(now - nextFrame) >= (long)period) nextFrame = now + period;
+  }
+
+  // Measured rate over one second windows
+  windowFrames++;
+  if (now - windowStart >= 1000) {
+    measuredFps = windowFrames * 1000.0f / (now - windowStart);
+    windowStart = now;
+    windowFrames = 0;
+  }
+}
+
+// Sleep until the next frame is due, waking at least every inputPollMs for the buttons
+void FrameGovernor::sleep(unsigned long now) const {
+  if (frameRequested) return;
+
+  unsigned long wait = inputPollMs;
+  if (targets[content] > 0) {
+    long untilFrame = (long)(nextFrame - now);
+    if (untilFrame <= 0) return;
+    if ((unsigned long)untilFrame < wait) wait = untilFrame;
+  }
+  delay(wait);
+}
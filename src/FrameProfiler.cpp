@@ -0,0 +1,36 @@
+#include "FrameProfiler.h"
+
+#include <algorithm>
+
+static const char* const sectionNames[FrameProfiler::SECTION_COUNT] = {
+  "updateData", "drawDisplay", "frame state", "background", "compose", "submit", "transfer",
+  "clock", "wifi", "temperature", "seconds", "fps", "min", "max", "graph",
+  "metric 0", "metric 1", "metric 2", "scroller", "updates"
+};
+static_assert(FrameProfiler::SECTION_COUNT == 20, "name every section (and frame widget) above");
+
+void FrameProfiler::record(Section section, uint32_t micros) {
+  Track& track = tracks[section];
+  track.samples[track.next] = micros < 0xFFFF ? micros : 0xFFFF;
+  track.next = (track.next + 1) & (window - 1);
+  if (track.count < window) track.count++;
+  track.calls++;
+  if (micros > track.worst) track.worst = micros;
+}
+
+// One line per section that ran since the last report, percentiles from a sorted copy of its window
+void FrameProfiler::report(Print& out) {
+  out.printf("Profile (us, last %u samples per section):\n", window);
+  out.printf("  %-12s %6s %6s %6s %6s\n", "section", "p50", "p99", "max", "calls");
+  uint16_t sorted[window];
+  for (uint8_t i = 0; i < SECTION_COUNT; i++) {
+    Track& track = tracks[i];
+    if (track.calls == 0) continue;
+    memcpy(sorted, track.samples, track.count * sizeof(uint16_t));
+    std::sort(sorted, sorted + track.count);
+    out.printf("  %-12s %6u %6u %6lu %6lu\n", sectionNames[i], sorted[(track.count - 1) * 50 / 100],
+               sorted[(track.count - 1) * 99 / 100], (unsigned long)track.worst, (unsigned long)track.calls);
+    track.calls = 0;
+    track.worst = 0;
+  }
+}
@@ -0,0 +1,99 @@
+#include "FramePush.h"
+
+bool FramePush::begin(int16_t width, int16_t height, UBaseType_t priority, BaseType_t core) {
+  if (width > maxWidth) return false;
+  buffer = (uint8_t*)malloc((size_t)width * height);
+  if (!buffer) return false;
+
+  queued = xSemaphoreCreateBinary();
+  idle = xSemaphoreCreateBinary();
+  if (queued && idle) {
+    xSemaphoreGive(idle);
+    if (xTaskCreatePinnedToCore(task, "push", 4096, this, priority, NULL, core) == pdPASS) return true;
+  }
+
+  // No push task to hand idle back: release everything so submit() takes the blocking path
+  if (queued) vSemaphoreDelete(queued);
+  if (idle) vSemaphoreDelete(idle);
+  queued = NULL;
+  idle = NULL;
+  free(buffer);
+  buffer = nullptr;
+  return false;
+}
+
+void FramePush::wait() {
+  if (!buffer) return;
+  xSemaphoreTake(idle, portMAX_DELAY);
+  xSemaphoreGive(idle);
+}
+
+uint32_t FramePush::submit(GreySprite& sprite, DirtyRegions& regions) {
+  if (regions.isEmpty()) return 0;
+
+  if (!buffer) {
+    // No second buffer: send straight from the sprite and wait for it
+    windowCount = regions.take(windows);
+    if (sprite.width() <= maxWidth) transfer(sprite.pixels(), sprite.width());
+    return queuedPixels();
+  }
+
+  // Fence: the previous frame must have left the transfer buffer
+  unsigned long stallStart = micros();
+  xSemaphoreTake(idle, portMAX_DELAY);
+  lastStall = micros() - stallStart;
+
+  // Pack each window's rows one after another
+  const uint8_t* frame = sprite.pixels();
+  uint8_t* out = buffer;
+  windowCount = regions.take(windows);
+  for (uint8_t i = 0; i < windowCount; i++) {
+    const Rect& r = windows[i];
+    for (int16_t row = 0; row < r.h; row++) {
+      memcpy(out, frame + (r.y + row) * sprite.width() + r.x, r.w);
+      out += r.w;
+    }
+  }
+  uint32_t pixels = queuedPixels();
+
+  xSemaphoreGive(queued);
+  return pixels;
+}
+
+uint32_t FramePush::queuedPixels() const {
+  uint32_t pixels = 0;
+  for (uint8_t i = 0; i < windowCount; i++) pixels += (uint32_t)windows[i].w * windows[i].h;
+  return pixels;
+}
+
+// Send the windows from frame rows stride indices apart, or packed one after another (stride 0)
+void FramePush::transfer(const uint8_t* frame, int16_t stride) {
+  unsigned long start = micros();
+  bool swapBytes = tft->getSwapBytes();
+  tft->setSwapBytes(false); // the table is in sprite byte order
+  tft->startWrite();
+  for (uint8_t i = 0; i < windowCount; i++) {
+    const Rect& r = windows[i];
+    const uint8_t* in = stride ? frame + r.y * stride + r.x : frame;
+    tft->setAddrWindow(r.x, r.y, r.w, r.h);
+    for (int16_t row = 0; row < r.h; row++) {
+      GreySprite::expand(line, in, r.w);
+      tft->pushPixels(line, r.w);
+      in += stride ? stride : r.w;
+    }
+    if (!stride) frame += (uint32_t)r.w * r.h;
+  }
+  tft->endWrite();
+  tft->setSwapBytes(swapBytes);
+  lastTransfer = micros() - start;
+  transferCount++;
+}
+
+void FramePush::task(void* param) {
+  FramePush* self = (FramePush*)param;
+  for (;;) {
+    xSemaphoreTake(self->queued, portMAX_DELAY);
+    self->transfer(self->buffer, 0);
+    xSemaphoreGive(self->idle);
+  }
+}
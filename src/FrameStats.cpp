@@ -0,0 +1,45 @@
+#include "FrameStats.h"
+
+// Bucket upper bounds in microseconds (the last bucket takes everything longer)
+static const uint32_t bucketLimits[FrameStats::bucketCount - 1] = {
+  20000, 35000, 50000, 70000, 100000, 250000, 500000, 1000000, 1500000
+};
+
+void FrameStats::frame(unsigned long nowMicros) {
+  if (started) add(nowMicros - last);
+  last = nowMicros;
+  started = true;
+}
+
+void FrameStats::add(uint32_t micros) {
+  // Idle gaps can last minutes, cap what the average sees so 8 x it can't overflow
+  uint32_t capped = micros < 60000000 ? micros : 60000000;
+  averageScaled = averageScaled == 0 ? capped * 8 : averageScaled - averageScaled / 8 + capped;
+  if (micros < shortest) shortest = micros;
+  if (micros > longest) longest = micros;
+  frames++;
+
+  uint8_t bucket = 0;
+  while (bucket < bucketCount - 1 && micros >= bucketLimits[bucket]) bucket++;
+  buckets[bucket]++;
+}
+
+uint16_t FrameStats::fps() const {
+  uint32_t frameTime = average();
+  return frameTime ? (1000000 + frameTime / 2) / frameTime : 0;
+}
+
+void FrameStats::report(Print& out) {
+  if (frames == 0) return;
+  out.printf("Frame time: avg %luus min %luus max %luus over %lu frames |", (unsigned long)average(),
+             (unsigned long)shortest, (unsigned long)longest, (unsigned long)frames);
+  for (uint8_t i = 0; i < bucketCount; i++) {
+    if (i < bucketCount - 1) out.printf(" <%lums %lu", (unsigned long)(bucketLimits[i] / 1000), (unsigned long)buckets[i]);
+    else out.printf(" more %lu", (unsigned long)buckets[i]);
+    buckets[i] = 0;
+  }
+  out.println();
+  shortest = UINT32_MAX;
+  longest = 0;
+  frames = 0;
+}
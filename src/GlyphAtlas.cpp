@@ -0,0 +1,115 @@
+#include "GlyphAtlas.h"
+
+// Render every glyph of charset into a scratch sprite and copy out its ink box
+bool GlyphAtlas::build(TFT_eSPI* tft, const FontCache& fonts, FontCache::Handle font, const char* charset, uint16_t fg, uint16_t bg) {
+  free(pixels);
+  pixels = nullptr;
+  pixelCount = 0;
+  count = 0;
+
+  TFT_eSprite scratch(tft);
+  fonts.select(scratch, font);
+  lineHeight = scratch.gFont.yAdvance;
+  ascent = scratch.gFont.maxAscent;
+
+  // Measure the tiles first so the pixels are one allocation
+  uint8_t widest = 0;
+  for (const char* p = charset; *p && count < maxGlyphs; p++) {
+    uint16_t gNum = 0;
+    if (find(*p) || !scratch.getUnicodeIndex((uint8_t)*p, &gNum)) continue;
+
+    // Ink outside its own cell would be painted over by the neighbouring tile, leave it to drawString()
+    if (scratch.gdX[gNum] < 0 || scratch.gdX[gNum] + scratch.gWidth[gNum] > scratch.gxAdvance[gNum]) continue;
+
+    Tile& tile = tiles[count++];
+    tile.code = *p;
+    tile.x = scratch.gdX[gNum];
+    tile.y = ascent - scratch.gdY[gNum];
+    tile.w = scratch.gWidth[gNum];
+    tile.h = scratch.gHeight[gNum];
+    tile.advance = scratch.gxAdvance[gNum];
+    tile.offset = pixelCount;
+    pixelCount += tile.w * tile.h;
+    if (tile.x + tile.w > widest) widest = tile.x + tile.w;
+  }
+
+  pixels = (uint8_t*)malloc(pixelCount);
+  if (!pixels || !scratch.createSprite(widest, lineHeight)) {
+    fonts.release(scratch); // the sprite must not free the cached tables
+    free(pixels);
+    pixels = nullptr;
+    count = 0;
+    return false;
+  }
+
+  scratch.setTextDatum(TL_DATUM);
+  scratch.setTextColor(fg, bg);
+  for (uint8_t i = 0; i < count; i++) {
+    const Tile& tile = tiles[i];
+    char text[2] = { tile.code, 0 };
+    scratch.fillSprite(bg);
+    scratch.drawString(text, 0, 0);
+    uint8_t* out = pixels + tile.offset;
+    for (uint8_t row = 0; row < tile.h; row++) {
+      for (uint8_t col = 0; col < tile.w; col++) *out++ = GreySprite::index(scratch.readPixel(tile.x + col, tile.y + row));
+    }
+  }
+
+  fonts.release(scratch);
+  scratch.deleteSprite();
+  return true;
+}
+
+const GlyphAtlas::Tile* GlyphAtlas::find(char code) const {
+  for (uint8_t i = 0; i < count; i++) {
+    if (tiles[i].code == code) return &tiles[i];
+  }
+  return nullptr;
+}
+
+bool GlyphAtlas::covers(const char* text) const {
+  if (!pixels) return false;
+  for (const char* p = text; *p; p++) {
+    if (!find(*p)) return false;
+  }
+  return true;
+}
+
+// TFT_eSPI's smooth font rule: advances for all but the last glyph, which counts to the right edge of its ink
+int16_t GlyphAtlas::textWidth(const char* text) const {
+  int16_t width = 0;
+  for (const char* p = text; *p; p++) {
+    const Tile* tile = find(*p);
+    if (!tile) continue;
+    width += p[1] ? tile->advance : tile->x + tile->w;
+  }
+  return width;
+}
+
+// Same datum arithmetic as drawString() so blitted and drawn text land on the same pixels
+bool GlyphAtlas::draw(GreySprite& target, const char* text, int32_t x, int32_t y, uint8_t datum) const {
+  if (!covers(text)) return false;
+
+  int32_t width = textWidth(text);
+  switch (datum) {
+    case TC_DATUM: x -= width / 2; break;
+    case TR_DATUM: x -= width; break;
+    case ML_DATUM: y -= lineHeight / 2; break;
+    case MC_DATUM: x -= width / 2; y -= lineHeight / 2; break;
+    case MR_DATUM: x -= width; y -= lineHeight / 2; break;
+    case BL_DATUM: y -= lineHeight; break;
+    case BC_DATUM: x -= width / 2; y -= lineHeight; break;
+    case BR_DATUM: x -= width; y -= lineHeight; break;
+    case L_BASELINE: y -= ascent; break;
+    case C_BASELINE: x -= width / 2; y -= ascent; break;
+    case R_BASELINE: x -= width; y -= ascent; break;
+    default: break;
+  }
+
+  for (const char* p = text; *p; p++) {
+    const Tile* tile = find(*p);
+    target.blit(x + tile->x, y + tile->y, tile->w, tile->h, pixels + tile->offset, tile->w);
+    x += tile->advance;
+  }
+  return true;
+}
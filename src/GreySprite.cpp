@@ -0,0 +1,65 @@
+#include "GreySprite.h"
+
+uint16_t GreySprite::colour(uint8_t index) {
+  int8_t red = index >> 3;
+  int8_t green = 2 * red + (index & 7) - 3;
+  if (green < 0) green = 0;
+  if (green > 0x3F) green = 0x3F;
+  return red << 11 | green << 5 | red;
+}
+
+// RGB565 of every index, byte-swapped like the pixels of a 16 bpp sprite
+const uint16_t* GreySprite::table() {
+  static uint16_t swapped[256];
+  static bool built = false;
+  if (!built) {
+    for (uint16_t i = 0; i < 256; i++) {
+      uint16_t c = colour(i);
+      swapped[i] = c << 8 | c >> 8;
+    }
+    built = true;
+  }
+  return swapped;
+}
+
+void GreySprite::expand(uint16_t* out, const uint8_t* in, uint32_t count) {
+  const uint16_t* lookup = table();
+  while (count--) *out++ = lookup[*in++];
+}
+
+void GreySprite::drawPixel(int32_t x, int32_t y, uint32_t color) {
+  uint8_t* frame = pixels();
+  if (!frame || x < 0 || y < 0 || x >= width() || y >= height()) return;
+  frame[x + y * width()] = index(color);
+}
+
+uint16_t GreySprite::readPixel(int32_t x, int32_t y) {
+  uint8_t* frame = pixels();
+  if (!frame || x < 0 || y < 0 || x >= width() || y >= height()) return 0xFFFF;
+  return colour(frame[x + y * width()]);
+}
+
+void GreySprite::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  uint8_t* frame = pixels();
+  if (!frame) return;
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > width()) w = width() - x;
+  if (y + h > height()) h = height() - y;
+  if (w <= 0 || h <= 0) return;
+
+  uint8_t value = index(color);
+  for (int32_t row = y; row < y + h; row++) memset(frame + row * width() + x, value, w);
+}
+
+void GreySprite::blit(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t* data, int32_t stride) {
+  uint8_t* frame = pixels();
+  if (!frame) return;
+  if (x < 0) { w += x; data -= x; x = 0; }
+  if (y < 0) { h += y; data -= y * stride; y = 0; }
+  if (x + w > width()) w = width() - x;
+  if (y + h > height()) h = height() - y;
+  if (w <= 0 || h <= 0) return;
+
+  for (int32_t row = 0; row < h; row++) memcpy(frame + (y + row) * width() + x, data + row * stride, w);
+}
@@ -0,0 +1,148 @@
+#include "HistoryLog.h"
+
+static const char* const logFiles[2] = { "/history0.log", "/history1.log" };
+static const uint16_t recordMagic = 0x4854; // "TH"
+static const uint8_t recordVersion = 1;
+static const uint8_t flagImperial = 0x01;
+
+uint32_t HistoryLog::crc32(const uint8_t* data, size_t length) {
+  uint32_t crc = 0xFFFFFFFF;
+  while (length--) {
+    crc ^= *data++;
+    for (uint8_t bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+bool HistoryLog::valid(const Record& record) {
+  return record.magic == recordMagic && record.version == recordVersion &&
+         record.crc == crc32((const uint8_t*)&record, offsetof(Record, crc));
+}
+
+bool HistoryLog::begin(bool imperial) {
+  flags = imperial ? flagImperial : 0;
+  mounted = LittleFS.begin(true);
+  return mounted;
+}
+
+// Sequence number of the first record in a file (false if missing or unreadable)
+bool HistoryLog::firstSeq(const char* path, uint32_t& seq) {
+  File file = LittleFS.open(path, "r");
+  if (!file) return false;
+  Record record;
+  bool ok = file.read((uint8_t*)&record, sizeof(record)) == sizeof(record) && valid(record);
+  file.close();
+  if (ok) seq = record.seq;
+  return ok;
+}
+
+// Epoch of the last complete record in a file (0 if it is damaged or has no clock time)
+uint32_t HistoryLog::lastEpoch(const char* path) {
+  File file = LittleFS.open(path, "r");
+  if (!file) return 0;
+  Record record;
+  size_t records = file.size() / sizeof(Record);
+  bool ok = records > 0 && file.seek((records - 1) * sizeof(Record)) &&
+            file.read((uint8_t*)&record, sizeof(record)) == sizeof(record) && valid(record);
+  file.close();
+  return ok ? record.epoch : 0;
+}
+
+uint16_t HistoryLog::replay(TempHistory& history) {
+  if (!mounted) return 0;
+
+  // The file that starts with the lower sequence number holds the older week (a lone file is the newer one)
+  uint32_t seq[2];
+  bool exists[2] = { firstSeq(logFiles[0], seq[0]), firstSeq(logFiles[1], seq[1]) };
+  uint8_t older = exists[0] && exists[1] ? (seq[0] < seq[1] ? 0 : 1) : (exists[0] ? 1 : 0);
+  uint8_t newer = 1 - older;
+
+  // Anything a week older than the newest record would only scroll through the tiers
+  Cursor cursor = { 0, 0 };
+  uint32_t newest = exists[newer] ? lastEpoch(logFiles[newer]) : 0;
+  uint32_t recordEnd = newest + recordSamples * TempHistory::sampleSeconds;
+  if (newest && recordEnd > TempHistory::spanSeconds) cursor.cutoff = recordEnd - TempHistory::spanSeconds;
+
+  uint16_t samples = 0;
+  uint16_t records = 0;
+  bool clean = true;
+  if (exists[older]) samples += replayFile(logFiles[older], history, cursor, records, clean);
+  active = older;
+  activeCount = records;
+  if (exists[newer]) {
+    records = 0;
+    clean = true;
+    samples += replayFile(logFiles[newer], history, cursor, records, clean);
+    active = newer;
+    activeCount = records;
+  }
+
+  // Records appended behind a damaged one would never be replayed - start the other file instead
+  rotate = !clean;
+  replayEnd = cursor.next;
+  return samples;
+}
+
+uint16_t HistoryLog::replayFile(const char* path, TempHistory& history, Cursor& cursor, uint16_t& records, bool& clean) {
+  File file = LittleFS.open(path, "r");
+  if (!file) return 0;
+
+  uint16_t samples = 0;
+  Record record;
+  while (file.available() > 0) {
+    if (file.read((uint8_t*)&record, sizeof(record)) != sizeof(record) || !valid(record)) {
+      clean = false;
+      break;
+    }
+    records++;
+    nextSeq = max(nextSeq, record.seq + 1);
+    if ((record.flags & flagImperial) != (flags & flagImperial)) continue; // other units
+    if (record.epoch && record.epoch < cursor.cutoff) continue;                // out of every range
+
+    // Samples are sampleSeconds apart, the time since the previous record's last one is a gap
+    if (record.epoch && cursor.next && record.epoch > cursor.next) {
+      history.skip((record.epoch - cursor.next + TempHistory::sampleSeconds / 2) / TempHistory::sampleSeconds);
+    }
+    for (uint8_t i = 0; i < recordSamples; i++) history.push(record.samples[i] / 100.0f);
+    samples += recordSamples;
+    cursor.next = record.epoch ? record.epoch + recordSamples * TempHistory::sampleSeconds : 0;
+  }
+  file.close();
+  return samples;
+}
+
+void HistoryLog::append(float value, uint32_t epoch) {
+  if (!mounted) return;
+  if (pendingCount == 0) pending.epoch = epoch;
+  pending.samples[pendingCount++] = (int16_t)lroundf(constrain(value * 100.0f, -32767.0f, 32767.0f));
+  if (pendingCount == recordSamples) {
+    writeRecord();
+    pendingCount = 0;
+  }
+}
+
+void HistoryLog::writeRecord() {
+  // Rotate: the other file (the oldest week) is truncated and becomes the active one
+  const char* mode = "a";
+  if (activeCount >= recordsPerFile || rotate) {
+    active = 1 - active;
+    activeCount = 0;
+    rotate = false;
+    mode = "w";
+  }
+
+  pending.magic = recordMagic;
+  pending.version = recordVersion;
+  pending.flags = flags;
+  pending.seq = nextSeq;
+  pending.crc = crc32((const uint8_t*)&pending, offsetof(Record, crc));
+
+  File file = LittleFS.open(logFiles[active], mode);
+  if (!file) return;
+  bool written = file.write((const uint8_t*)&pending, sizeof(pending)) == sizeof(pending);
+  file.close();
+  if (written) {
+    nextSeq++;
+    activeCount++;
+  }
+}
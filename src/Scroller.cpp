@@ -0,0 +1,52 @@
+#include "Scroller.h"
+
+bool Scroller::begin(int16_t width, int16_t height, uint16_t background, uint16_t pixelsPerSecond) {
+  windowWidth = width;
+  windowHeight = height;
+  bg = background;
+  speed = pixelsPerSecond;
+  if (!strip.createSprite(maxTextWidth, height)) return false;
+  strip.fillSprite(bg);
+  blank = GreySprite::index(bg);
+  return true;
+}
+
+// Render the message with the canvas font and colours, restart it from the right edge
+bool Scroller::setMessage(const String& message, int16_t textY, unsigned long now) {
+  if (shows(message) || !strip.created()) return false;
+  text = message;
+  started = now;
+
+  strip.fillSprite(bg);
+  strip.setTextDatum(TL_DATUM);
+  strip.drawString(text.c_str(), 0, textY);
+  int16_t width = strip.textWidth(text.c_str());
+  textWidth = width < maxTextWidth ? width : maxTextWidth;
+  return true;
+}
+
+// Enters at the right edge, wraps once it has left on the left
+int16_t Scroller::position(unsigned long now) const {
+  if (!active()) return windowWidth;
+  uint32_t period = windowWidth + textWidth;
+  uint32_t travelled = (uint64_t)(now - started) * speed / 1000 % period;
+  return windowWidth - (int16_t)travelled;
+}
+
+void Scroller::draw(GreySprite& target, int16_t x, int16_t y, int16_t textX) {
+  const uint8_t* source = strip.pixels();
+  uint8_t* frame = target.pixels();
+  if (!source || !frame) return;
+
+  // Visible part of the text in window columns [from, to)
+  int16_t from = textX > 0 ? textX : 0;
+  int16_t to = textX + textWidth < windowWidth ? textX + textWidth : windowWidth;
+  if (to < from) to = from;
+
+  for (int16_t row = 0; row < windowHeight; row++) {
+    uint8_t* line = frame + (y + row) * target.width() + x;
+    memset(line, blank, from);
+    memcpy(line + from, source + row * maxTextWidth + (from - textX), to - from);
+    memset(line + to, blank, windowWidth - to);
+  }
+}
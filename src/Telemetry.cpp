@@ -0,0 +1,104 @@
+#include "Telemetry.h"
+
+#include <string.h>
+
+// Same CRC-32 (reflected, 0xEDB88320) as the history log, zlib.crc32() on the host gives the same value
+uint32_t Telemetry::crc32(const uint8_t* data, size_t length) {
+  uint32_t crc = 0xFFFFFFFF;
+  while (length--) {
+    crc ^= *data++;
+    for (uint8_t bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+static uint8_t* put(uint8_t* out, uint32_t value, uint8_t bytes) {
+  for (uint8_t i = 0; i < bytes; i++) *out++ = (uint8_t)(value >> (8 * i));
+  return out;
+}
+
+static uint32_t get(const uint8_t*& in, uint8_t bytes) {
+  uint32_t value = 0;
+  for (uint8_t i = 0; i < bytes; i++) value |= (uint32_t)*in++ << (8 * i);
+  return value;
+}
+
+size_t Telemetry::encode(const Record& record, uint8_t* out) {
+  uint8_t* p = out;
+  *p++ = sync0;
+  *p++ = sync1;
+  *p++ = version;
+  *p++ = recordBytes;
+  p = put(p, record.sequence, 4);
+  p = put(p, record.uptimeMs, 4);
+  p = put(p, record.frameAverageUs, 4);
+  p = put(p, record.frameMinUs, 4);
+  p = put(p, record.frameMaxUs, 4);
+  p = put(p, record.frames, 4);
+  p = put(p, record.heapFree, 4);
+  p = put(p, record.heapLargestBlock, 4);
+  p = put(p, record.fetchConnectMs, 4);
+  p = put(p, record.fetchRequestMs, 4);
+  p = put(p, (uint8_t)record.rssi, 1);
+  p = put(p, record.weatherRetries, 1);
+  p = put(p, record.timeSyncRetries, 1);
+  p = put(p, crc32(out + 2, headerBytes - 2 + recordBytes), 4);
+  return p - out;
+}
+
+void Telemetry::decode(const uint8_t* in, Record& record) {
+  record.sequence = get(in, 4);
+  record.uptimeMs = get(in, 4);
+  record.frameAverageUs = get(in, 4);
+  record.frameMinUs = get(in, 4);
+  record.frameMaxUs = get(in, 4);
+  record.frames = get(in, 4);
+  record.heapFree = get(in, 4);
+  record.heapLargestBlock = get(in, 4);
+  record.fetchConnectMs = get(in, 4);
+  record.fetchRequestMs = get(in, 4);
+  record.rssi = (int8_t)get(in, 1);
+  record.weatherRetries = get(in, 1);
+  record.timeSyncRetries = get(in, 1);
+}
+
+bool Telemetry::Parser::push(uint8_t byte, Record& record) {
+  // Hunt for the sync byte, nothing is buffered between frames
+  if (used == 0 && byte != sync0) return false;
+  frame[used++] = byte;
+
+  while (used > 0) {
+    if (used < 2) return false;
+    if (frame[1] != sync1) {
+      drop(1);
+      continue;
+    }
+    if (used < headerBytes) return false;
+
+    uint8_t length = frame[3];
+    uint16_t total = headerBytes + length + crcBytes;
+    if (used < total) return false;
+
+    const uint8_t* crc = frame + headerBytes + length;
+    if (get(crc, 4) != crc32(frame + 2, headerBytes - 2 + length)) {
+      errors++;
+      drop(1);
+      continue;
+    }
+    // Newer versions append fields, anything shorter than version 1 is not ours
+    if (frame[2] < 1 || length < recordBytes) {
+      drop(1);
+      continue;
+    }
+    decode(frame + headerBytes, record);
+    drop(total);
+    return true;
+  }
+  return false;
+}
+
+void Telemetry::Parser::drop(uint16_t bytes) {
+  while (bytes < used && frame[bytes] != sync0) bytes++;
+  used -= bytes;
+  memmove(frame, frame + bytes, used);
+}
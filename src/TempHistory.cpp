@@ -0,0 +1,103 @@
+#include "TempHistory.h"
+
+static const char* const rangeLabels[TempHistory::RANGE_COUNT] = { "LAST 2 HOURS", "LAST 12 HOURS", "LAST 7 DAYS" };
+
+// Degrees to the centi-degree fixed point stored in the tiers
+static int16_t toCenti(float value) {
+  return (int16_t)lroundf(constrain(value * 100.0f, -32767.0f, 32767.0f));
+}
+
+void TempHistory::push(float value) {
+  int16_t centi = toCenti(value);
+  TempBucket sample = { centi, centi, centi };
+  add(sample);
+  graphDirty = true;
+}
+
+void TempHistory::skip(uint32_t samples) {
+  // After a week of gaps every tier shows only gaps, more changes nothing
+  samples = min<uint32_t>(samples, spanSeconds / sampleSeconds);
+  for (uint32_t i = 0; i < samples; i++) add(noTemp);
+  if (samples) graphDirty = true;
+}
+
+// Each tier passes its completed buckets down to the next
+void TempHistory::add(const TempBucket& sample) {
+  TempBucket halfHour, threeHour;
+  if (raw.add(sample, halfHour) && halfHours.add(halfHour, threeHour)) {
+    TempBucket done;
+    threeHours.add(threeHour, done);
+  }
+}
+
+void TempHistory::setRange(Range newRange) {
+  if (newRange == selected) return;
+  selected = newRange;
+  graphDirty = true;
+}
+
+const char* TempHistory::label() const {
+  return rangeLabels[selected];
+}
+
+bool TempHistory::empty() const {
+  switch (selected) {
+    case LAST_2_HOURS: return !raw.hasTemps();
+    case LAST_12_HOURS: return !halfHours.hasTemps();
+    default: return !threeHours.hasTemps();
+  }
+}
+
+float TempHistory::minimum() const {
+  switch (selected) {
+    case LAST_2_HOURS: return raw.low() / 100.0f;
+    case LAST_12_HOURS: return halfHours.low() / 100.0f;
+    default: return threeHours.low() / 100.0f;
+  }
+}
+
+float TempHistory::maximum() const {
+  switch (selected) {
+    case LAST_2_HOURS: return raw.high() / 100.0f;
+    case LAST_12_HOURS: return halfHours.high() / 100.0f;
+    default: return threeHours.high() / 100.0f;
+  }
+}
+
+const uint8_t* TempHistory::graph() {
+  if (graphDirty) {
+    switch (selected) {
+      case LAST_2_HOURS: project(raw); break;
+      case LAST_12_HOURS: project(halfHours); break;
+      default: project(threeHours); break;
+    }
+    graphDirty = false;
+  }
+  return bars;
+}
+
+// Average the bucket averages per column (an unfilled tier is aligned to the right)
+template <class Tier>
+void TempHistory::project(const Tier& tier) {
+  int32_t sums[columns] = {};
+  uint8_t counts[columns] = {};
+  uint16_t missing = Tier::capacity() - tier.size();
+  for (uint16_t i = 0; i < tier.size(); i++) {
+    TempBucket bucket = tier[i];
+    if (!hasTemp(bucket)) continue; // gaps leave their column empty
+    uint8_t column = (uint32_t)(missing + i) * columns / Tier::capacity();
+    sums[column] += bucket.avg;
+    counts[column]++;
+  }
+
+  int32_t low = tier.hasTemps() ? tier.low() : 0;
+  int32_t range = tier.hasTemps() ? tier.high() - low : 0;
+  for (uint8_t c = 0; c < columns; c++) {
+    if (counts[c] == 0 || range <= 0) {
+      bars[c] = 0;
+      continue;
+    }
+    int32_t level = (sums[c] / counts[c] - low) * levels / range;
+    bars[c] = (uint8_t)constrain(level, 0, (int32_t)levels);
+  }
+}
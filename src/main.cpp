@@ -9,7 +9,10 @@
 #include <WiFiManager.h>
 #include <ArduinoJson.h>
 #include <HTTPClient.h>
+#include <WiFiClientSecure.h>
 #include <ESP32Time.h>
+#include <Preferences.h>
+#include <esp_sntp.h>
 
 // Font libraries
 #include "NotoSansBold15.h"
@@ -18,18 +21,60 @@
 #include "midleFont.h"
 #include "bigFont.h"
 #include "font18.h"
+#include "FontCache.h"
+#include "DirtyRegions.h"
+#include "FrameGovernor.h"
+#include "BootTimeline.h"
+#include "TempHistory.h"
+#include "HistoryLog.h"
+#include "Layout.h"
+#include "BarGraph.h"
+#include "GlyphAtlas.h"
+#include "AllocCounter.h"
+#include "TextBuffer.h"
+#include "GreySprite.h"
+#include "Scroller.h"
+#include "FramePush.h"
+#include "FrameProfiler.h"
+#include "FrameStats.h"
+#include "Telemetry.h"
 
 /* 
 Create display and sprite objects:
  - lcd: Main display object
- - sprite: Primary drawing surface
- - errSprite: For error messages
+ - sprite: Primary drawing surface (8-bit grey indices, expanded to RGB565 when pushed - see GreySprite.h)
+ - bgSprite: Pre-rendered static layout copied into sprite each frame (same format)
  - rtc: For time functions
 */
 TFT_eSPI lcd = TFT_eSPI();
-TFT_eSprite sprite = TFT_eSprite(&lcd);
-TFT_eSprite errSprite = TFT_eSprite(&lcd);
-ESP32Time rtc(0);
+GreySprite sprite = GreySprite(&lcd);
+GreySprite bgSprite = GreySprite(&lcd);
+const long rtcOffset = 0; // seconds added on top of the system clock (captureTime applies it too)
+ESP32Time rtc(rtcOffset);
+
+// Smooth fonts are parsed once in setup() and switched by handle in drawDisplay()
+FontCache fontCache;
+FontCache::Handle fontHandles[FONT_COUNT]; // indexed by FontId (FONT_GLCD unused)
+
+// Positions, styles and dirty bounds of everything on screen (see Layout.h)
+constexpr const Layout& layout = defaultLayout::layout;
+
+// Only the parts of the sprite that changed are pushed to the panel
+DirtyRegions dirtyRegions(320, 170);
+FramePush framePush(&lcd); // sends them from core 0 while the next frame is drawn
+unsigned long dataVersion = 0; // bumped whenever weather or history data changes
+bool backgroundDirty = true; // set when units/location/graph range change to re-render bgSprite
+
+// History bars, kept in the background layer and repainted only when the graph changes
+BarGraph barGraph(&lcd);
+
+// Pre-blended tiles for the numeric fields (blitted instead of drawn glyph by glyph)
+GlyphAtlas temperatureGlyphs;
+GlyphAtlas secondsGlyphs;
+GlyphAtlas metricGlyphs; // shared by the three metric boxes
+
+// Bottom ticker, rendered once per message and scrolled by copying a window of it
+Scroller scroller(&lcd);
 
 //#################### EDIT THIS SECTION ###################
 int offsetGMT = 2; // GMT+(your offset)
@@ -37,45 +82,106 @@ String location = "CITY_NAME"; // your city/town
 String countryCode = "CODE"; // Country code (GB / US / ZA / etc)
 String owmAPI = "YOUR_API_KEY"; // your Open Weather Map API key
 String units = "metric";  // metric, imperial
+
+// Frame rate targets (0 = redraw only when the data changes)
+uint8_t scrollingFps = 30; // while the bottom ticker scrolls
+uint8_t clockFps = 1;      // when only the clock changes
+uint8_t scrollSpeed = 30;  // ticker speed in pixels per second (independent of the frame rate)
+
+// Diagnostics
+uint16_t profileSeconds = 60; // per-section frame timings (p50/p99) on serial every N seconds, 0 = off
+bool serialTelemetry = true;  // binary telemetry frame with each 10s report (decode with tools/telemetry_decode.cpp)
 //##########################################################
 
 // Button pins
-int BootButton = 0; // GPIO0 for left button (used to decrease brightness)
-int KeyButton = 14; // GPIO14 for right button (used to increase brightness)
+int BootButton = 0; // GPIO0 for left button (press: decrease brightness, hold: previous graph range)
+int KeyButton = 14; // GPIO14 for right button (press: increase brightness, hold: next graph range)
+const unsigned long holdTime = 600; // ms before a press counts as a hold
 
 const char* ntpServer = "pool.ntp.org";
 
+/*
+One long-lived HTTPS connection to OpenWeatherMap (network task only):
+ - requests go out as HTTP/1.1 keep-alive, so back-to-back requests skip the TLS handshake
+ - fetchTiming splits each request into connect (TCP + TLS) and request (send to parsed) time
+*/
+const char* owmHost = "api.openweathermap.org";
+WiFiClientSecure owmClient;
+HTTPClient owmHttp;
+
+struct FetchTiming {
+  unsigned long connectMs; // 0 when the connection was reused
+  unsigned long requestMs;
+  bool reused;
+  unsigned long requestStart;
+};
+FetchTiming fetchTiming = {};
+
 // Store coordinates after first successful lookup
 float storedLat = 0;
 float storedLon = 0;
 
+/*
+NVS cache (namespace "weather") so a reboot doesn't start from nothing:
+ - place/lat/lon: geocoded coordinates for location + "," + countryCode
+ - units/layout/snapshot: the last successful weather reading, painted at boot while the network comes up
+   (layout is snapshotLayout when it was written, a mismatch drops the snapshot)
+*/
+Preferences prefs;
+
+/*
+Asynchronous boot (network task), the dashboard is drawn from the first loop() with placeholders:
+ - Wi-Fi, then geocoding and the weather fetch, while NTP synchronises in the background
+ - bootStage drives the ticker text, the portal and fatal errors take over the screen
+ - bootTimeline records when each phase finished and is printed on serial once all are done
+*/
+enum BootStage : uint8_t {
+  BOOT_WIFI,
+  BOOT_LOCATION,
+  BOOT_WEATHER,
+  BOOT_DONE,
+  BOOT_PORTAL,          // Wi-Fi portal open (screen shows instructions)
+  BOOT_PORTAL_COMPLETE, // restarting after the portal
+  BOOT_LOCATION_FAILED  // geocoding failed, halted
+};
+volatile BootStage bootStage = BOOT_WIFI;
+volatile bool timeSynced = false;   // clock shows placeholders until NTP answers
+bool weatherReady = false;          // at least one reading applied (cache or live)
+BootTimeline bootTimeline;
+bool bootReported = false;
+
 // Additional variables
 int brightness = 175; // initial brightness (half of 100-250 in steps of 25 - lower than 80 causes screen flickering)
-int scrollPosition = 100;
-bool firstUpdate = true;
 unsigned long lastUpdate = 0;
 int updatesCounter = 0;
 unsigned long lastMillis = 0;
-long lastFrameTime = 0;  // for FPS calculation
-int framesPerSecond = 0; // current FPS
+FrameStats frameStats; // frame times: smoothed for the FPS field, min/max/histogram on serial
+
+// Paces drawDisplay() per content class and sleeps the loop task in between (buttons polled every 20ms)
+FrameGovernor frameGovernor(clockFps, scrollingFps, 20);
+unsigned long lastFpsReport = 0;
+uint32_t frameAllocations = 0; // heap allocations made while drawing, since the last report
 
-// Colours
-#define bck TFT_BLACK
-unsigned short greys[13];
+// Where the frame time goes: updateData(), the drawDisplay() stages, each widget and the panel push
+FrameProfiler profiler;
+unsigned long lastProfileReport = 0;
 
-// Static strings of data showed on right side 
-const char* dataLabel[] = { "HUMID", "PRESS", "WIND" };
-String dataLabelUnits[] = { "%", "hPa", "m/s" };
+// Colours, indexed by the layout colour slots: 13 greys (light to dark), black, white
+unsigned short colours[colourSlots];
+
+// Units of the data showed on right side (labels are in the layout)
+const char* dataLabelUnits[] = { "%", "hPa", "m/s" };
 
 // Weather data variables
 float temperature = 00.00;
 float feelsLike = 00.00;
-float maxTemp;
-float minTemp;
 float weatherMetrics[3];
-float tempHistory[24] = {};
-float tempHistoryTemp[24] = {};
-int tempHistoryGraph[24] = { 0 };
+
+// One sample per 5 minute update, kept at 5 minute, 30 minute and 3 hour resolution
+// The graph, MIN and MAX show the range picked with the buttons (12 hours at boot)
+TempHistory tempHistory;
+HistoryLog historyLog; // replayed in setup(), appended by the network task
+uint32_t historyResumeEpoch = 0; // end of the replayed log, the first live sample fills the time since with a gap
 
 // Scrolling message on bottom right side
 String scrollMessage = "";
@@ -83,7 +189,32 @@ String conditions = "";
 String sunriseTime = "";
 String sunsetTime = "";
 
-// Retry mechanism variables
+/*
+Weather results published by the network task:
+ - networkTask() owns netWeather and fetches on core 0 so drawing never waits on HTTP/TLS
+ - each update is copied into weatherQueue (length 1, overwritten) and picked up by updateData()
+ - updatesCounter advances on every 5 minute tick, even when the fetch failed
+*/
+struct WeatherSnapshot {
+  bool valid;          // at least one fetch succeeded
+  float temperature;
+  float feelsLike;
+  float metrics[3];
+  char conditions[48];
+  long sunrise;
+  long sunset;
+  int updatesCounter;
+};
+
+// Bump when WeatherSnapshot's fields change: the raw struct is cached in NVS, older layouts are ignored
+const uint32_t snapshotLayout = 1;
+
+WeatherSnapshot netWeather = {};
+WeatherSnapshot savedWeather = {}; // what NVS holds (network task), an unchanged reading isn't rewritten
+QueueHandle_t weatherQueue = NULL;
+TaskHandle_t networkTaskHandle = NULL;
+
+// Retry mechanism variables (network task only)
 unsigned long lastRetryTime = 0;
 const unsigned long retryInterval = 10000; // 10 seconds between retries
 int timeSyncRetries = 0;
@@ -97,31 +228,59 @@ bool weatherSyncNeeded = false;
 ********************** HELPER FUNCTIONS **********************
 **************************************************************/
 
-// Function to adjust screen brightness using buttons
-void adjustBrightness() {
-  // Static variables to store previous button states
-  static uint8_t prevBootBtn = HIGH, prevKeyBtn = HIGH;
+// Button state for press/hold detection
+struct Button {
+  int pin;
+  uint8_t prev;
+  unsigned long pressedAt;
+  bool held; // hold already reported for this press
+};
+Button bootBtn = { BootButton, HIGH, 0, false };
+Button keyBtn = { KeyButton, HIGH, 0, false };
+
+enum ButtonEvent : uint8_t { NO_PRESS, PRESSED, HELD };
+
+// Function to read a button: PRESSED on release of a short press, HELD once when held for holdTime
+ButtonEvent readButton(Button& button) {
+  uint8_t curr = digitalRead(button.pin); // active LOW
+  ButtonEvent event = NO_PRESS;
+
+  if (button.prev == HIGH && curr == LOW) {
+    button.pressedAt = millis();
+    button.held = false;
+  } else if (curr == LOW && !button.held && millis() - button.pressedAt >= holdTime) {
+    button.held = true;
+    event = HELD;
+  } else if (button.prev == LOW && curr == HIGH && !button.held) {
+    event = PRESSED;
+  }
+
+  button.prev = curr;
+  return event;
+}
+
+// Function to handle the buttons (brightness on a press, graph range on a hold)
+void handleButtons() {
   const int step = 25; // step size (25 provides 7 steps between 100-250)
-  
-  // Read current button states (active LOW)
-  uint8_t currBootBtn = digitalRead(BootButton);
-  uint8_t currKeyBtn = digitalRead(KeyButton);
-  
-  // Detect falling edge (HIGH->LOW transition) on Boot button
-  if (prevBootBtn == HIGH && currBootBtn == LOW) {
+  ButtonEvent boot = readButton(bootBtn);
+  ButtonEvent key = readButton(keyBtn);
+
+  if (boot == PRESSED) {
     brightness = constrain(brightness - step, 100, 250); // decrease brightness, constrained to 100-250 range
     analogWrite(TFT_BL, brightness); // apply new brightness to backlight pin
   }
-  
-  // Detect falling edge (HIGH->LOW transition) on Key button
-  if (prevKeyBtn == HIGH && currKeyBtn == LOW) {
+  if (key == PRESSED) {
     brightness = constrain(brightness + step, 100, 250); // increase brightness, constrained to 100-250 range
     analogWrite(TFT_BL, brightness); // apply new brightness to backlight pin
   }
-  
-  // Store current button states for next iteration
-  prevBootBtn = currBootBtn;
-  prevKeyBtn = currKeyBtn;
+
+  // The range label is part of the background layer
+  if (boot == HELD || key == HELD) {
+    if (boot == HELD) tempHistory.previousRange();
+    else tempHistory.nextRange();
+    backgroundDirty = true;
+    dataVersion++;
+  }
 }
 
 // Function to convert UNIX timestamp to readable time
@@ -160,6 +319,96 @@ void setTime() {
   }
 }
 
+// Function to load cached coordinates and the last weather snapshot (returns true if a snapshot was found)
+bool loadWeatherCache(WeatherSnapshot& weather) {
+  prefs.begin("weather", true);
+  bool samePlace = prefs.isKey("place") && prefs.getString("place") == location + "," + countryCode;
+  if (samePlace) {
+    storedLat = prefs.getFloat("lat", 0);
+    storedLon = prefs.getFloat("lon", 0);
+  }
+  bool haveSnapshot = samePlace && prefs.isKey("units") && prefs.getString("units") == units &&
+                      prefs.getUInt("layout", 0) == snapshotLayout &&
+                      prefs.getBytesLength("snapshot") == sizeof(WeatherSnapshot) &&
+                      prefs.getBytes("snapshot", &weather, sizeof(WeatherSnapshot)) == sizeof(WeatherSnapshot);
+  prefs.end();
+
+  if (!haveSnapshot) return false;
+  weather.updatesCounter = 0; // the updates counter restarts on every boot
+  savedWeather = weather;
+  return weather.valid;
+}
+
+// Function to save the geocoded coordinates (drops the snapshot, it belongs to the previous place)
+void saveCoordinates() {
+  prefs.begin("weather", false);
+  prefs.putString("place", location + "," + countryCode);
+  prefs.putFloat("lat", storedLat);
+  prefs.putFloat("lon", storedLon);
+  prefs.remove("snapshot");
+  prefs.end();
+  savedWeather = {};
+}
+
+// Function to compare two readings, ignoring the updates counter (it moves on every fetch)
+bool sameReading(const WeatherSnapshot& a, const WeatherSnapshot& b) {
+  return a.valid == b.valid && a.temperature == b.temperature && a.feelsLike == b.feelsLike &&
+         memcmp(a.metrics, b.metrics, sizeof(a.metrics)) == 0 && strcmp(a.conditions, b.conditions) == 0 &&
+         a.sunrise == b.sunrise && a.sunset == b.sunset;
+}
+
+// Function to save the last weather reading for the next boot (skipped when NVS already holds it)
+void saveWeatherSnapshot(const WeatherSnapshot& weather) {
+  if (sameReading(weather, savedWeather)) return;
+  prefs.begin("weather", false);
+  prefs.putString("units", units);
+  prefs.putUInt("layout", snapshotLayout);
+  prefs.putBytes("snapshot", &weather, sizeof(WeatherSnapshot));
+  prefs.end();
+  savedWeather = weather;
+}
+
+// Function to send a GET over the persistent OpenWeatherMap connection (returns the HTTP code)
+int owmGet(const String& url) {
+  unsigned long start = millis();
+  fetchTiming.reused = owmClient.connected();
+  if (!fetchTiming.reused && !owmClient.connect(owmHost, 443)) {
+    fetchTiming.connectMs = millis() - start;
+    return HTTPC_ERROR_CONNECTION_REFUSED;
+  }
+  fetchTiming.connectMs = millis() - start;
+
+  fetchTiming.requestStart = millis();
+  owmHttp.begin(owmClient, url);
+  int httpCode = owmHttp.GET();
+  if (httpCode >= 0) return httpCode;
+
+  // Transport error: HTTPClient leaves our client open, don't reuse a connection in an unknown state
+  owmHttp.end();
+  owmClient.stop();
+  // The server may have closed the idle keep-alive connection under us, retry once on a fresh one
+  if (fetchTiming.reused) return owmGet(url);
+  return httpCode;
+}
+
+// Function to parse the response body with a filter
+DeserializationError owmParse(JsonDocument& doc, JsonDocument& filter) {
+  // Parse directly from the stream when the length is known, a chunked body has to be decoded by getString()
+  if (owmHttp.getSize() >= 0) {
+    return deserializeJson(doc, owmHttp.getStream(), DeserializationOption::Filter(filter));
+  }
+  return deserializeJson(doc, owmHttp.getString(), DeserializationOption::Filter(filter));
+}
+
+// Function to finish a request (the connection stays open for the next one unless the body wasn't consumed)
+void owmEnd(const char* name, bool completed) {
+  owmHttp.end();
+  if (!completed) owmClient.stop(); // unread response bytes would be taken for the next response
+  fetchTiming.requestMs = millis() - fetchTiming.requestStart;
+  Serial.printf("%s: connect %lums%s, request %lums\n", name, fetchTiming.connectMs,
+                fetchTiming.reused ? " (reused)" : "", fetchTiming.requestMs);
+}
+
 // Function to get coordinates for the location (required for weather data call)
 bool getLocationCords() {
   if (storedLat != 0 && storedLon != 0) return true;
@@ -174,103 +423,112 @@ bool getLocationCords() {
     }
   }
   
-  String geoUrl = "http://api.openweathermap.org/geo/1.0/direct?q=" + urlLocation + "," + countryCode + "&limit=1&appid=" + owmAPI;
+  String geoUrl = "https://api.openweathermap.org/geo/1.0/direct?q=" + urlLocation + "," + countryCode + "&limit=1&appid=" + owmAPI;
   
-  HTTPClient http;
-  http.begin(geoUrl);
-  int httpCode = http.GET();
+  int httpCode = owmGet(geoUrl);
   
   if (httpCode == HTTP_CODE_OK) {
-    String payload = http.getString();
-    
+    // Keep only the coordinates of each result
+    JsonDocument filter;
+    filter[0]["lat"] = true;
+    filter[0]["lon"] = true;
+
     JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, payload);
+    DeserializationError error = owmParse(doc, filter);
     
     if (!error && doc.size() > 0) {
       storedLat = doc[0]["lat"];
       storedLon = doc[0]["lon"];
-      http.end();
+      owmEnd("Geo", true);
+      saveCoordinates();
       return true; // coordinates found
     }
   }
-  http.end();
+  owmEnd("Geo", false);
   return false; // coordinates not found
 }
 
-// Function to get current weather data (returns true if successful)
-bool getWeatherData() {
+// Function to get current weather data into a snapshot (returns true if successful)
+bool getWeatherData(WeatherSnapshot& weather) {
   // Get current weather with stored coordinates
   String weatherUrl = "https://api.openweathermap.org/data/2.5/weather?lat=" + 
                      String(storedLat, 6) + "&lon=" + String(storedLon, 6) + 
                      "&units=" + units + "&appid=" + owmAPI;
   
-  HTTPClient httpWeather;
-  httpWeather.begin(weatherUrl);
-  int weatherCode = httpWeather.GET();
+  int weatherCode = owmGet(weatherUrl);
   
   if (weatherCode == HTTP_CODE_OK) {
-    String payload = httpWeather.getString();
-    
+    // Keep only the fields the display uses
+    JsonDocument filter;
+    filter["main"]["temp"] = true;
+    filter["main"]["feels_like"] = true;
+    filter["main"]["humidity"] = true;
+    filter["main"]["pressure"] = true;
+    filter["wind"]["speed"] = true;
+    filter["weather"][0]["description"] = true;
+    filter["sys"]["sunrise"] = true;
+    filter["sys"]["sunset"] = true;
+
     JsonDocument weatherDoc;
-    DeserializationError error = deserializeJson(weatherDoc, payload);
+    DeserializationError error = owmParse(weatherDoc, filter);
     
     if (!error) {
-      // Clean up city name (remove " Airport" if present)
-      String cityName = weatherDoc["name"].as<String>();
-      if (cityName.endsWith(" Airport")) {
-        cityName = cityName.substring(0, cityName.length() - 8);
-      }
-      
-      temperature = weatherDoc["main"]["temp"];
-      
-      // Update min and max temperatures on startup
-      if (firstUpdate) {
-        minTemp = temperature;
-        maxTemp = temperature;
-        firstUpdate = false;
-      }
-
-      feelsLike = weatherDoc["main"]["feels_like"];
-      weatherMetrics[0] = weatherDoc["main"]["humidity"];
-      weatherMetrics[1] = weatherDoc["main"]["pressure"];
-      weatherMetrics[2] = weatherDoc["wind"]["speed"];
+      weather.temperature = weatherDoc["main"]["temp"];
+      weather.feelsLike = weatherDoc["main"]["feels_like"];
+      weather.metrics[0] = weatherDoc["main"]["humidity"];
+      weather.metrics[1] = weatherDoc["main"]["pressure"];
+      weather.metrics[2] = weatherDoc["wind"]["speed"];
       
       // Get weather description
-      conditions = weatherDoc["weather"][0]["description"].as<String>();
-      conditions.setCharAt(0, toupper(conditions[0])); // capitalize first letter
+      String description = weatherDoc["weather"][0]["description"].as<String>();
+      description.setCharAt(0, toupper(description[0])); // capitalize first letter
+      strlcpy(weather.conditions, description.c_str(), sizeof(weather.conditions));
       
       // Get sunrise/sunset times
-      long sunrise = weatherDoc["sys"]["sunrise"];
-      long sunset = weatherDoc["sys"]["sunset"];
-      sunriseTime = formatUnixTime(sunrise);
-      sunsetTime = formatUnixTime(sunset);
-      
-      // Update message
-      scrollMessage = "#Conditions: " + conditions + "  #Feels like: " + formatTemperature(feelsLike) + "C" + "  #Sunrise: " + sunriseTime + "  #Sunset: " + sunsetTime;
-      httpWeather.end();
+      weather.sunrise = weatherDoc["sys"]["sunrise"];
+      weather.sunset = weatherDoc["sys"]["sunset"];
+      weather.valid = true;
+      owmEnd("Weather", true);
+      saveWeatherSnapshot(weather);
+      bootTimeline.mark(BootTimeline::WEATHER, millis());
       return true;
     }
   }
   
-  httpWeather.end();
+  owmEnd("Weather", false);
   return false;
 }
 
-// Function to update weather data
-void updateData() {
-  // Update scrolling message position
-  scrollPosition--;
-  if (scrollPosition < -450) scrollPosition = 180; // changed -420 to -450 | 100 to 180
+// Function to take the NTP time into the RTC (network task)
+void applyTimeSync(struct tm& timeinfo) {
+  rtc.setTimeStruct(timeinfo);
+  timeSynced = true;
+  bootTimeline.mark(BootTimeline::TIME, millis());
+}
 
+// SNTP notification (lwIP task): NTP answered while the boot pipeline carried on
+void onTimeSync(struct timeval*) {
+  struct tm timeinfo;
+  if (getLocalTime(&timeinfo, 0)) applyTimeSync(timeinfo);
+}
+
+// Function to run the time/weather schedule (network task)
+void syncNetwork() {
   // Current time for retry checks
   unsigned long currentMillis = millis();
 
+  // Startup latency, once every phase has finished
+  if (!bootReported && bootTimeline.complete()) {
+    bootTimeline.report(Serial);
+    bootReported = true;
+  }
+
   // Check if we need to retry time sync
   if (timeSyncNeeded && currentMillis > lastRetryTime + retryInterval) {
     if (timeSyncRetries < maxRetries) {
       struct tm timeinfo;
       if (getLocalTime(&timeinfo)) {
-        rtc.setTimeStruct(timeinfo);
+        applyTimeSync(timeinfo);
         timeSyncNeeded = false;
         timeSyncRetries = 0;
       } else {
@@ -283,9 +541,10 @@ void updateData() {
   // Check if we need to retry weather data
   if (weatherSyncNeeded && currentMillis > lastRetryTime + retryInterval) {
     if (weatherRetries < maxRetries) {
-      if (getWeatherData()) {  // modified to return bool (see next step)
+      if (getWeatherData(netWeather)) {
         weatherSyncNeeded = false;
         weatherRetries = 0;
+        xQueueOverwrite(weatherQueue, &netWeather);
       } else {
         weatherRetries++;
         lastRetryTime = currentMillis;
@@ -296,11 +555,11 @@ void updateData() {
   // Regular update check (every 5 minutes)
   if (currentMillis > lastUpdate + 300000) { 
     lastUpdate = currentMillis;
-    updatesCounter++;
+    netWeather.updatesCounter++;
     
     // Reset counter if it reaches 1000 (not enough space for 4 digits)
-    if (updatesCounter >= 1000) {
-      updatesCounter = 1;
+    if (netWeather.updatesCounter >= 1000) {
+      netWeather.updatesCounter = 1;
     }
 
     // Try to sync time first
@@ -310,12 +569,12 @@ void updateData() {
       timeSyncRetries = 0;
       lastRetryTime = currentMillis;
     } else {
-      rtc.setTimeStruct(timeinfo);
+      applyTimeSync(timeinfo);
       timeSyncNeeded = false;
     }
 
     // Then try to get weather data
-    if (!getWeatherData()) {  // modified to return bool (see next step)
+    if (!getWeatherData(netWeather)) {
       weatherSyncNeeded = true;
       weatherRetries = 0;
       lastRetryTime = currentMillis;
@@ -323,165 +582,503 @@ void updateData() {
       weatherSyncNeeded = false;
     }
 
-    // Update min and max temperatures
-    if (temperature < minTemp) {
-      minTemp = temperature;
-    }
-    if (temperature > maxTemp) {
-      maxTemp = temperature;
-    }
+    // Publish the tick (with the last good readings if the fetch failed), the same sample goes to flash
+    xQueueOverwrite(weatherQueue, &netWeather);
+    if (netWeather.valid) historyLog.append(netWeather.temperature, timeSynced ? rtc.getEpoch() : 0);
+  }
+}
 
-    // Update temperature history graph (30-min intervals)
-    tempHistory[23] = temperature;
-    for (int i = 23; i > 0; i--) {
-      tempHistory[i - 1] = tempHistoryTemp[i];
-    }
+// Function to connect Wi-Fi, start NTP and fetch the first weather (network task, at boot)
+void runBootPipeline() {
+  // Configure WiFiManager
+  WiFiManager wifiManager;
+  wifiManager.setConfigPortalTimeout(10); // 10 second timeout for initial connection
+  wifiManager.setConnectTimeout(10);      // 10 second connection timeout
 
-    for (int i = 0; i < 24; i++) {
-      tempHistoryTemp[i] = tempHistory[i];
+  // Attempt Wi-Fi connection, fall back to the configuration portal
+  if (!wifiManager.autoConnect("T-Display-S3", "123456789")) {
+    bootStage = BOOT_PORTAL;
+    wifiManager.setConfigPortalTimeout(0); // keep portal open indefinitely
+    wifiManager.startConfigPortal("T-Display-S3", "123456789");
+
+    // If we get here, configuration was completed
+    bootStage = BOOT_PORTAL_COMPLETE;
+    delay(3000);
+    ESP.restart();
+  }
+  bootTimeline.mark(BootTimeline::WIFI, millis());
+  Serial.printf("WiFi connected: %s, IP %s\n", WiFi.SSID().c_str(), WiFi.localIP().toString().c_str());
+
+  // NTP synchronises in the background, onTimeSync() takes the time when it arrives
+  sntp_set_time_sync_notification_cb(onTimeSync);
+  configTime(3600 * offsetGMT, 0, ntpServer);
+
+  // Persistent OpenWeatherMap connection (no CA bundle on the board, so the certificate isn't verified)
+  owmClient.setInsecure();
+  owmHttp.setReuse(true);
+
+  // Attempt to fetch location data (cached coordinates skip the lookup)
+  bootStage = BOOT_LOCATION;
+  if (!getLocationCords()) {
+    bootStage = BOOT_LOCATION_FAILED;
+    for (;;) vTaskDelay(portMAX_DELAY); // halt, the screen shows the error
+  }
+  bootTimeline.mark(BootTimeline::LOCATION, millis());
+
+  // First live reading (replaces a cached snapshot), failures go through the retry schedule
+  bootStage = BOOT_WEATHER;
+  if (getWeatherData(netWeather)) {
+    xQueueOverwrite(weatherQueue, &netWeather);
+  } else {
+    weatherSyncNeeded = true;
+    weatherRetries = 0;
+    lastRetryTime = millis();
+  }
+  bootStage = BOOT_DONE;
+}
+
+// Network task: runs the boot pipeline, then fetches on core 0 and publishes results to the render loop
+void networkTask(void*) {
+  runBootPipeline();
+  for (;;) {
+    syncNetwork();
+    vTaskDelay(pdMS_TO_TICKS(250));
+  }
+}
+
+// Function to apply a weather snapshot to the display data (render loop)
+void applyWeather(const WeatherSnapshot& weather) {
+  if (weather.valid) {
+    temperature = weather.temperature;
+    feelsLike = weather.feelsLike;
+    for (int i = 0; i < 3; i++) {
+      weatherMetrics[i] = weather.metrics[i];
     }
 
-    // Calculate graph scaling based on current min/max
-    for (int i = 0; i < 24; i++) {
-      tempHistoryGraph[i] = map(tempHistory[i], minTemp, maxTemp, 0, 12);
+    weatherReady = true;
+
+    conditions = weather.conditions;
+    sunriseTime = formatUnixTime(weather.sunrise);
+    sunsetTime = formatUnixTime(weather.sunset);
+
+    // Update message
+    scrollMessage = "#Conditions: " + conditions + "  #Feels like: " + formatTemperature(feelsLike) + "C" + "  #Sunrise: " + sunriseTime + "  #Sunset: " + sunsetTime;
+  }
+
+  // A new 5 minute tick adds a history sample
+  if (weather.updatesCounter != updatesCounter) {
+    updatesCounter = weather.updatesCounter;
+
+    // Add to the temperature history (min/max follow the window, the graph is re-projected when drawn)
+    if (weatherReady) {
+      // The first sample after a boot: the ticks missed while the device was off show as a gap
+      if (historyResumeEpoch && timeSynced && rtc.getEpoch() > historyResumeEpoch) {
+        tempHistory.skip((rtc.getEpoch() - historyResumeEpoch + TempHistory::sampleSeconds / 2) / TempHistory::sampleSeconds);
+      }
+      historyResumeEpoch = 0;
+      tempHistory.push(temperature);
     }
   }
+  dataVersion++;
+}
+
+// Function to pick up the latest weather published by the network task
+void updateData() {
+  WeatherSnapshot weather;
+  if (xQueueReceive(weatherQueue, &weather, 0) == pdTRUE) {
+    applyWeather(weather);
+  }
+
+  // Until the first reading arrives the ticker shows what the boot is waiting for
+  static BootStage lastStage = BOOT_DONE;
+  BootStage stage = bootStage;
+  if (!weatherReady && stage != lastStage) {
+    lastStage = stage;
+    if (stage == BOOT_WIFI) scrollMessage = "#Connecting to Wi-Fi - please wait...";
+    else if (stage == BOOT_LOCATION) scrollMessage = "#Finding location...";
+    else if (stage == BOOT_WEATHER) scrollMessage = "#Fetching weather data - please wait...";
+    else if (stage == BOOT_DONE) scrollMessage = "#Weather data unavailable - retrying...";
+    dataVersion++;
+  }
 }
 
 // Function to get WiFi signal strength in dBm
-String WiFiSignalStrength() {
+void WiFiSignalStrength(TextBuffer<12>& out) {
   long rssi = WiFi.RSSI();
-  return String(rssi) + "dBm";
+  out.clear().add(rssi).add("dBm");
 }
 
-// Function to calculate and update FPS
+// Function to add this frame to the frame-time statistics (microseconds, any frame length is fine)
 void updateFPS() {
-  // Calculate FPS
-  framesPerSecond = 1000 / (millis() - lastFrameTime);
-  lastFrameTime = millis();
+  frameStats.frame(micros());
+}
+
+// Function to send one binary telemetry frame on serial (format in Telemetry.h)
+void sendTelemetry() {
+  static uint32_t sequence = 0;
+  Telemetry::Record record;
+  record.sequence = sequence++;
+  record.uptimeMs = millis();
+  record.frameAverageUs = frameStats.average();
+  record.frameMinUs = frameStats.minimum();
+  record.frameMaxUs = frameStats.maximum();
+  record.frames = frameStats.count();
+  record.heapFree = ESP.getFreeHeap();
+  record.heapLargestBlock = ESP.getMaxAllocHeap();
+  record.fetchConnectMs = fetchTiming.connectMs;
+  record.fetchRequestMs = fetchTiming.requestMs;
+  record.rssi = WiFi.status() == WL_CONNECTED ? WiFi.RSSI() : 0;
+  record.weatherRetries = weatherRetries;
+  record.timeSyncRetries = timeSyncRetries;
+
+  uint8_t frame[Telemetry::frameBytes];
+  Serial.write(frame, Telemetry::encode(record, frame));
+}
+
+// Function to replace the dashboard with the Wi-Fi portal or a boot error (drawn once per stage)
+void showBootMessage(BootStage stage) {
+  static BootStage shownStage = BOOT_WIFI;
+  if (stage == shownStage) return;
+  shownStage = stage;
+
+  framePush.wait(); // the last frame may still be on the bus
+  lcd.fillScreen(TFT_BLACK);
+  lcd.setCursor(0, 0);
+  if (stage == BOOT_PORTAL) {
+    lcd.println("\nConnection timed out!");
+    lcd.println("\nA Wi-Fi network has been created:");
+    lcd.println("SSID: T-Display-S3");
+    lcd.println("Password: 123456789");
+    lcd.println("\nConnect and navigate to: 192.168.4.1");
+    lcd.println("in a browser to setup your Wi-Fi.");
+  } else if (stage == BOOT_PORTAL_COMPLETE) {
+    lcd.println("\nWiFi configuration complete!");
+    lcd.println("\nRestarting in 3seconds...");
+  } else {
+    lcd.println("\nFailed to get location!");
+    lcd.println("Check location name in the code and try again.");
+  }
+}
+
+// Function to apply a layout text style (the built-in font releases any smooth font)
+void applyStyle(TFT_eSprite& target, const TextStyle& style) {
+  if (style.font == FONT_GLCD) {
+    fontCache.release(target);
+  } else {
+    fontCache.select(target, fontHandles[style.font]);
+  }
+  target.setTextDatum(style.datum);
+  target.setTextColor(colours[style.fg], colours[style.bg]);
+}
+
+// Function to draw a layout shape
+void drawShape(TFT_eSprite& target, const Shape& shape) {
+  const Rect& r = shape.area;
+  switch (shape.kind) {
+    case SHAPE_LINE:
+      target.drawLine(r.x, r.y, r.x + r.w, r.y + r.h, colours[shape.colour]);
+      break;
+    case SHAPE_RECT:
+      target.fillRect(r.x, r.y, r.w, r.h, colours[shape.colour]);
+      break;
+    case SHAPE_ROUND_RECT:
+      target.fillRoundRect(r.x, r.y, r.w, r.h, shape.radius, colours[shape.colour]);
+      break;
+    case SHAPE_SMOOTH_RECT:
+      target.fillSmoothRoundRect(r.x, r.y, r.w, r.h, shape.radius, colours[shape.colour], colours[shape.bg]);
+      break;
+    case SHAPE_CIRCLE:
+      target.fillCircle(r.x, r.y, shape.radius, colours[shape.colour]);
+      break;
+  }
+}
+
+// Function to pick the glyph atlas of a frame widget (null when it is drawn with the font)
+GlyphAtlas* widgetGlyphs(WidgetId id) {
+  switch (id) {
+    case W_TEMPERATURE:
+      return &temperatureGlyphs;
+    case W_SECONDS:
+      return &secondsGlyphs;
+    case W_METRIC0:
+    case W_METRIC1:
+    case W_METRIC2:
+      return &metricGlyphs;
+    default:
+      return nullptr;
+  }
+}
+
+// Function to draw a text widget at its layout anchor (blitted from its atlas when every character is in it)
+void drawWidgetText(GreySprite& target, WidgetId id, const char* text) {
+  const Widget& widget = layout.widget(id);
+  const GlyphAtlas* glyphs = widgetGlyphs(id);
+  if (glyphs && glyphs->draw(target, text, widget.x, widget.y, widget.style.datum)) return;
+
+  applyStyle(target, widget.style);
+  target.drawString(text, widget.x, widget.y);
+}
+
+// Function to re-render the ticker strip when the message changed (the position follows the clock)
+void updateScroll() {
+  if (scroller.shows(scrollMessage)) return;
+  const Widget& widget = layout.widget(W_SCROLLER);
+  applyStyle(scroller.canvas(), widget.style);
+  scroller.setMessage(scrollMessage, widget.y, millis());
+  fontCache.release(scroller.canvas());
+}
+
+// Wall clock read once per loop pass, the text is only re-formatted when the second changes
+struct TimeSnapshot {
+  time_t epoch = 0;
+  bool synced = false;
+  bool secondChanged = true;
+  TextBuffer<6> clock;   // HH:MM
+  TextBuffer<3> seconds; // SS
+};
+TimeSnapshot timeNow;
+
+// Per-frame inputs, read once so drawing and change detection agree (fixed buffers, no heap)
+struct FrameState {
+  TextBuffer<12> wifiSignal;
+  int16_t scrollX; // ticker text position in its window
+};
+
+// What the frame sprite currently shows, so only the widgets that changed are redrawn
+struct ScreenState {
+  unsigned long dataVersion = ~0UL; // forces a full redraw on the first frame
+  TextBuffer<6> clock;
+  TextBuffer<3> seconds;
+  TextBuffer<12> wifiSignal;
+  int fps = -1;
+  int16_t scrollX = -1;
+};
+ScreenState shown;
+
+// Text of one widget (the longest is the location name)
+typedef TextBuffer<32> WidgetText;
+
+// Function to take the time snapshot for this loop pass (placeholders until NTP answers)
+void captureTime() {
+  // One clock read per frame, the tm is derived from it so the minute and seconds can't straddle a tick
+  bool synced = timeSynced;
+  time_t epoch = synced ? time(nullptr) + rtcOffset : 0;
+  timeNow.secondChanged = epoch != timeNow.epoch || synced != timeNow.synced || timeNow.clock.length() == 0;
+  if (!timeNow.secondChanged) return;
+
+  timeNow.epoch = epoch;
+  timeNow.synced = synced;
+  if (synced) {
+    tm now;
+    localtime_r(&epoch, &now);
+    timeNow.clock.clear().format("%02d:%02d", now.tm_hour, now.tm_min);
+    timeNow.seconds.clear().format("%02d", now.tm_sec);
+  } else {
+    timeNow.clock.clear().add("--:--");
+    timeNow.seconds.clear().add("--");
+  }
+}
+
+// Function to read the signal strength and ticker position for this frame
+void readFrameState(FrameState& frame) {
+  WiFiSignalStrength(frame.wifiSignal);
+  frame.scrollX = scroller.position(millis());
+}
+
+// Function to format the text of a widget into out
+void widgetText(WidgetId id, const FrameState& frame, WidgetText& out) {
+  const char* tempUnit = units == "metric" ? "C" : "F";
+  out.clear();
+
+  switch (id) {
+    case W_UNITS:
+      out.add(tempUnit);
+      break;
+    case W_LOCATION:
+      out.add(location.c_str());
+      break;
+    case W_RANGE:
+      out.add(tempHistory.label());
+      break;
+    case W_CLOCK:
+      out.add(timeNow.clock.c_str()); // without seconds
+      break;
+    case W_SECONDS:
+      out.add(timeNow.seconds.c_str());
+      break;
+    case W_WIFI:
+      out.add(frame.wifiSignal.c_str());
+      break;
+    case W_TEMPERATURE:
+      if (weatherReady) out.add(temperature, 1);
+      else out.add("--.-");
+      break;
+    case W_FPS:
+      out.add("FPS:").add((int)frameStats.fps());
+      break;
+    case W_MIN:
+    case W_MAX: {
+      // The current reading until the first history sample is taken
+      float value = tempHistory.empty() ? temperature : (id == W_MIN ? tempHistory.minimum() : tempHistory.maximum());
+      out.add(id == W_MIN ? "MIN:" : "MAX:");
+      if (weatherReady) out.add(value, 2);
+      else out.add("--");
+      out.add(tempUnit);
+      break;
+    }
+    case W_METRIC0:
+    case W_METRIC1:
+    case W_METRIC2: {
+      int i = id - W_METRIC0;
+      if (weatherReady) out.add((int)weatherMetrics[i]);
+      else out.add("--");
+      out.add(dataLabelUnits[i]);
+      break;
+    }
+    case W_UPDATES:
+      out.add("UPDATES:").add(updatesCounter);
+      break;
+    default:
+      break;
+  }
+}
+
+// Function to draw the static layout (labels, divider, boxes, axes) into a background layer
+void drawBackground(GreySprite& target) {
+  target.fillSprite(TFT_BLACK);
+
+  for (uint8_t i = 0; i < layout.shapeCount; i++) {
+    drawShape(target, layout.shapes[i]);
+  }
+  for (uint8_t i = 0; i < layout.labelCount; i++) {
+    const Label& label = layout.labels[i];
+    applyStyle(target, label.style);
+    target.drawString(label.text, label.x, label.y);
+  }
+
+  // Settings that only change with units, location or graph range
+  FrameState none;
+  WidgetText text;
+  for (uint8_t id = 0; id < firstFrameWidget; id++) {
+    widgetText((WidgetId)id, none, text);
+    drawWidgetText(target, (WidgetId)id, text.c_str());
+  }
+  fontCache.release(target);
+}
+
+// Function to copy a rectangle of the background layer into the frame (clears a widget before it is redrawn)
+void restoreBackground(const Rect& r) {
+  sprite.blit(r.x, r.y, r.w, r.h, bgSprite.pixels() + r.y * 320 + r.x, 320);
+}
+
+// Function to draw one frame widget
+void drawWidget(WidgetId id, const FrameState& frame) {
+  FrameProfiler::Scope timing(profiler, FrameProfiler::widgetSection(id));
+  switch (id) {
+    case W_GRAPH:
+      if (!bgSprite.created()) barGraph.draw(sprite, tempHistory.graph()); // already in the background layer
+      break;
+    case W_SCROLLER: {
+      const Rect& bounds = layout.widget(W_SCROLLER).bounds;
+      scroller.draw(sprite, bounds.x, bounds.y, frame.scrollX);
+      break;
+    }
+    default: {
+      WidgetText text;
+      widgetText(id, frame, text);
+      drawWidgetText(sprite, id, text.c_str());
+      break;
+    }
+  }
+}
+
+// Function to tell whether a widget differs from what is on screen (data widgets change with dataVersion)
+bool widgetChanged(WidgetId id, const FrameState& frame) {
+  switch (id) {
+    case W_CLOCK:
+      return timeNow.clock != shown.clock;
+    case W_SECONDS:
+      return timeNow.seconds != shown.seconds;
+    case W_WIFI:
+      return frame.wifiSignal != shown.wifiSignal;
+    case W_FPS:
+      return frameStats.fps() != shown.fps;
+    case W_SCROLLER:
+      return frame.scrollX != shown.scrollX;
+    default:
+      return false;
+  }
 }
 
 // Function to draw the display
 void drawDisplay() {
-  // Update error sprite with scrolling message
-  errSprite.fillSprite(greys[10]);
-  errSprite.setTextColor(greys[1], greys[10]);
-  errSprite.drawString(scrollMessage, scrollPosition, 4);
-  
-  // Clear main sprite and draw divider line
-  sprite.fillSprite(TFT_BLACK);
-  sprite.drawLine(138, 10, 138, 164, greys[6]);
-  sprite.setTextDatum(0);
-  
-  // Left side elements
-  sprite.loadFont(midleFont);
-  sprite.setTextColor(greys[1], TFT_BLACK);
-  sprite.drawString("WEATHER", 6, 10);
-  sprite.unloadFont();
-  
-  sprite.loadFont(font18);
-  sprite.setTextColor(greys[7], TFT_BLACK);
-  sprite.drawString("LOC:", 11, 110);
-  sprite.setTextColor(greys[2], TFT_BLACK);
-  sprite.drawString(units == "metric" ? "C" : "F", 19, 52);
-  sprite.fillCircle(13, 54, 2, greys[2]);
-  
-  sprite.setTextColor(greys[3], TFT_BLACK);
-  sprite.drawString(location, 45, 110);
-  sprite.unloadFont();
-  
-  // Draw time (without seconds)
-  sprite.loadFont(tinyFont);
-  sprite.setTextColor(greys[4], TFT_BLACK);
-  sprite.drawString(rtc.getTime().substring(0, 5), 10, 132);
-  sprite.unloadFont();
-  
-  // Static text element
-  sprite.setTextColor(greys[5], TFT_BLACK);
-  sprite.drawString("INTERNET", 85, 10);
-  sprite.drawString("STATION", 85, 20);
+  FrameProfiler::Scope total(profiler, FrameProfiler::DRAW_DISPLAY);
+  FrameState frame;
+  {
+    FrameProfiler::Scope timing(profiler, FrameProfiler::FRAME_STATE);
+    readFrameState(frame);
+  }
 
-  sprite.drawString("WiFi signal:", 10, 37);
+  // Re-render the background layer when the layout inputs (units/location) changed
+  if (backgroundDirty && bgSprite.created()) {
+    FrameProfiler::Scope timing(profiler, FrameProfiler::BACKGROUND);
+    drawBackground(bgSprite);
+    barGraph.invalidate();
+    backgroundDirty = false;
+    dataVersion++; // whole frame changes
+  }
 
-  // Wi-Fi signal strength
-  sprite.drawString(WiFiSignalStrength(), 85, 37);
-  
-  // Main temperature display
-  sprite.setTextDatum(4);
-  sprite.loadFont(bigFont);
-  sprite.setTextColor(greys[0], TFT_BLACK);
-  sprite.drawFloat(temperature, 1, 74, 82);
-  sprite.unloadFont();
-  
-  // Seconds display
-  sprite.fillRoundRect(92, 132, 23, 22, 2, greys[2]);
-  sprite.loadFont(font18);
-  sprite.setTextColor(TFT_BLACK, greys[2]);
-  sprite.drawString(rtc.getTime().substring(6, 8), 103, 145);
-  sprite.unloadFont();
-  sprite.setTextDatum(0);
-
-  // FPS display
-  sprite.setTextColor(greys[7], TFT_BLACK);
-  sprite.drawString("FPS:" + String(framesPerSecond), 92, 157);
-  
-  // Right side elements
-  sprite.loadFont(font18);
-  sprite.setTextColor(greys[1], TFT_BLACK);
-  sprite.drawString("LAST 12 HOURS", 144, 10);
-  sprite.unloadFont();
-  
-  sprite.fillRect(144, 28, 84, 2, greys[10]);
-  
-  // Min/Max temperature display
-  sprite.setTextColor(greys[3], TFT_BLACK);
-  String tempUnit = units == "metric" ? "C" : "F";
-  sprite.drawString("MIN:" + String(minTemp) + tempUnit, 252, 10);
-  sprite.drawString("MAX:" + String(maxTemp) + tempUnit, 252, 20);
-  
-  // Temperature graph
-  sprite.fillSmoothRoundRect(144, 34, 174, 60, 3, greys[10], bck);
-  sprite.drawLine(170, 39, 170, 88, TFT_WHITE);
-  sprite.drawLine(170, 88, 314, 88, TFT_WHITE);
-  
-  sprite.setTextDatum(4);
-  for (int j = 0; j < 24; j++) {
-    for (int i = 0; i < tempHistoryGraph[j]; i++) {
-      sprite.fillRect(173 + (j * 6), 83 - (i * 4), 4, 3, greys[2]);
+  // Repaint the bars in the background layer only when the history graph changed
+  const uint8_t* tempHistoryGraph = tempHistory.graph();
+  if (bgSprite.created() && barGraph.changed(tempHistoryGraph)) {
+    FrameProfiler::Scope timing(profiler, FrameProfiler::BACKGROUND);
+    barGraph.draw(bgSprite, tempHistoryGraph);
+    dataVersion++;
+  }
+
+  if (dataVersion != shown.dataVersion || !bgSprite.created()) {
+    // Data changed: start from the background layer (drawn in place if there wasn't memory for it)
+    FrameProfiler::Scope timing(profiler, FrameProfiler::COMPOSE);
+    if (bgSprite.created()) {
+      memcpy(sprite.pixels(), bgSprite.pixels(), 320 * 170);
+    } else {
+      drawBackground(sprite);
+    }
+    for (uint8_t id = firstFrameWidget; id < WIDGET_COUNT; id++) {
+      drawWidget((WidgetId)id, frame);
+    }
+    dirtyRegions.markAll();
+    shown.dataVersion = dataVersion;
+  } else {
+    // Otherwise redraw only the widgets that changed, each over its own patch of background
+    for (uint8_t id = firstFrameWidget; id < WIDGET_COUNT; id++) {
+      if (!widgetChanged((WidgetId)id, frame)) continue;
+      const Rect& bounds = layout.widget((WidgetId)id).bounds;
+      restoreBackground(bounds);
+      drawWidget((WidgetId)id, frame);
+      dirtyRegions.add(bounds);
     }
   }
-  
-  sprite.setTextColor(greys[2], greys[10]);
-  sprite.drawString("MAX", 158, 42);
-  sprite.drawString("MIN", 158, 86);
-  
-  sprite.loadFont(font18);
-  sprite.setTextColor(greys[7], greys[10]);
-  sprite.drawString("T", 158, 65);
-  sprite.unloadFont();
-  
-  // Weather metrics boxes
-  for (int i = 0; i < 3; i++) {
-    sprite.fillSmoothRoundRect(144 + (i * 60), 100, 54, 32, 3, greys[9], bck);
-    sprite.setTextColor(greys[3], greys[9]);
-    sprite.drawString(dataLabel[i], 144 + (i * 60) + 27, 107);
-    sprite.setTextColor(greys[2], greys[9]);
-    sprite.loadFont(font18);
-    sprite.drawString(String((int)weatherMetrics[i]) + dataLabelUnits[i], 144 + (i * 60) + 27, 124);
-    sprite.unloadFont();
+  fontCache.release(sprite);
+
+  shown.clock = timeNow.clock;
+  shown.seconds = timeNow.seconds;
+  shown.wifiSignal = frame.wifiSignal;
+  shown.fps = frameStats.fps();
+  shown.scrollX = frame.scrollX;
+
+  // Hand only the changed regions to the push task
+  {
+    FrameProfiler::Scope timing(profiler, FrameProfiler::SUBMIT);
+    framePush.submit(sprite, dirtyRegions);
+  }
+
+  // The push task's bus time, recorded here once per finished transfer
+  static uint32_t profiledTransfers = 0;
+  if (framePush.transfers() != profiledTransfers) {
+    profiledTransfers = framePush.transfers();
+    profiler.record(FrameProfiler::TRANSFER, framePush.transferMicros());
   }
-  
-  // Bottom status bar
-  sprite.fillSmoothRoundRect(144, 148, 174, 16, 2, greys[10], bck);
-  errSprite.pushToSprite(&sprite, 148, 150);
-  
-  sprite.setTextColor(greys[4], bck);
-  sprite.drawString("CURRENT INFO", 182, 142);
-  sprite.setTextColor(greys[7], bck);
-  sprite.drawString("UPDATES:" + String(updatesCounter), 285, 142);
-  
-  // Push final sprite to display
-  sprite.pushSprite(0, 0);
 }
 
 
@@ -491,6 +1088,12 @@ void drawDisplay() {
 
 // SETUP
 void setup() {
+  // Serial for frame rate reports
+  Serial.begin(115200);
+
+  // Count the heap allocations of this task (setup() and loop() share it) to keep drawing allocation-free
+  AllocCounter::watch(xTaskGetCurrentTaskHandle());
+
   // Initialize hardware
   pinMode(15, OUTPUT);
   digitalWrite(15, 1);
@@ -507,106 +1110,114 @@ void setup() {
   ledcAttachPin(38, 0);
   ledcWrite(0, 130);
   
-  // Display Wi-Fi connection message
-  lcd.println("\nConnecting to Wi-Fi - please wait...");
-  
-  // Configure WiFiManager
-  WiFiManager wifiManager;
-  wifiManager.setConfigPortalTimeout(10); // 10 second timeout for initial connection
-  wifiManager.setConnectTimeout(10);      // 10 second connection timeout
-  
-  // Attempt Wi-Fi connection
-  if (!wifiManager.autoConnect("T-Display-S3", "123456789")) {
-    lcd.println("\nConnection timed out!");
-    lcd.println("\nA Wi-Fi network has been created:");
-    lcd.println("SSID: T-Display-S3");
-    lcd.println("Password: 123456789");
-    lcd.println("\nConnect and navigate to: 192.168.4.1");
-    lcd.println("in a browser to setup your Wi-Fi.");
-    
-    // Start configuration portal
-    wifiManager.setConfigPortalTimeout(0); // keep portal open indefinitely
-    wifiManager.startConfigPortal("T-Display-S3", "123456789");
-    
-    // If we get here, configuration was completed
-    lcd.fillScreen(TFT_BLACK);
-    lcd.setCursor(0, 0);
-    lcd.println("\nWiFi configuration complete!");
-    lcd.println("\nRestarting in 3seconds...");
-    delay(3000);
-    ESP.restart();
-  }
-  
-  // Connection successful
-  lcd.println("\nWiFi connected!");
-  lcd.print("SSID: ");
-  lcd.println(WiFi.SSID());
-  lcd.print("IP: ");
-  lcd.println(WiFi.localIP());
-  delay(2000);
-  
-  // Time sync message
-  lcd.println("\nSyncing time - please wait...");
-  
-  // Configure NTP time
-  configTime(3600 * offsetGMT, 0, ntpServer);
-  
-  // Attempt time sync
-  struct tm timeinfo;
-  unsigned long syncStart = millis();
-  while(!getLocalTime(&timeinfo)) {
-    if (millis() - syncStart > 10000) { // 10 second timeout
-      lcd.println("\nTime sync failed!");
-      lcd.println("Check internet connection and try again.");
-      while(1); // halt execution
-    }
-  }
-  
-  // Time sync complete
-  rtc.setTimeStruct(timeinfo);
-  lcd.println("\nTime synchronized!");
-  lcd.print("Current time: ");
-  lcd.println(rtc.getTime());
-  delay(2000);
-  
-  // Weather data message
-  lcd.println("\nFetching weather data - please wait...");
-  
-  // Attempt to fetch location data
-  if (!getLocationCords()) {
-    lcd.println("\nFailed to get location!");
-    lcd.println("Check location name in the code and try again.");
-    while(1); // halt execution
-  }
-  getWeatherData();
-
-  // Weather data fetch complete
-  lcd.println("Weather data received!\nLoading final assets...");
-  
   // Generate 13 levels of grey
   int co = 210;
   for (int i = 0; i < 13; i++) {
-    greys[i] = lcd.color565(co, co, co);
+    colours[i] = lcd.color565(co, co, co);
     co = co - 20;
   }
+  colours[SLOT_BLACK] = TFT_BLACK;
+  colours[SLOT_WHITE] = TFT_WHITE;
   
   // Initialize sprites
   sprite.createSprite(320, 170);
-  errSprite.createSprite(164, 15);
-  
-  // Ready message
-  lcd.println("\nSystem ready!");
-  lcd.println("Starting main display...");
-  delay(2000);
+  const Widget& ticker = layout.widget(W_SCROLLER);
+  scroller.begin(ticker.bounds.w, ticker.bounds.h, colours[ticker.style.bg], scrollSpeed);
+  bgSprite.createSprite(320, 170); // PSRAM - drawDisplay() falls back to drawing the layout in place
+  framePush.begin(320, 170, 2, 0); // above the network task, falls back to blocking pushes without memory
+
+  barGraph.begin(layout.graph, TempHistory::columns, TempHistory::levels, colours[layout.graph.colour], colours[layout.widget(W_GRAPH).style.bg]);
+
+  // Parse the smooth fonts once (metric tables stay on the heap for the lifetime of the sketch)
+  fontHandles[FONT_MIDLE] = fontCache.add(sprite, midleFont);
+  fontHandles[FONT_18] = fontCache.add(sprite, font18);
+  fontHandles[FONT_TINY] = fontCache.add(sprite, tinyFont);
+  fontHandles[FONT_BIG] = fontCache.add(sprite, bigFont);
+
+  // Pre-render the digits of the numeric fields against their box colours
+  for (WidgetId id : { W_TEMPERATURE, W_SECONDS, W_METRIC0 }) {
+    const Widget& widget = layout.widget(id);
+    GlyphAtlas* glyphs = widgetGlyphs(id);
+    glyphs->build(&lcd, fontCache, fontHandles[widget.style.font], widget.glyphs, colours[widget.style.fg], colours[widget.style.bg]);
+  }
+  Serial.printf("Glyph atlas: %u bytes\n", (unsigned)(temperatureGlyphs.bytes() + secondsGlyphs.bytes() + metricGlyphs.bytes()));
+
+  // Start from the last known weather if a previous boot cached it (placeholders otherwise)
+  if (loadWeatherCache(netWeather)) {
+    applyWeather(netWeather);
+  }
+
+  // Rebuild the temperature history from the flash log
+  if (historyLog.begin(units != "metric")) {
+    unsigned long replayStart = millis();
+    uint16_t samples = historyLog.replay(tempHistory);
+    historyResumeEpoch = historyLog.replayedUntil();
+    Serial.printf("History: %u samples replayed in %lums\n", samples, millis() - replayStart);
+  }
+
+  // Start the network task on core 0 (loop() runs on core 1) - it brings up Wi-Fi, NTP and the weather
+  // while the dashboard is already drawing (larger stack for the WiFiManager portal)
+  weatherQueue = xQueueCreate(1, sizeof(WeatherSnapshot));
+  xTaskCreatePinnedToCore(networkTask, "network", 12288, NULL, 1, &networkTaskHandle, 0);
 }
 
 // MAIN LOOP
 void loop() {
-  // Call functions & update display
-  adjustBrightness();
-  updateData();
-  updateFPS();
-  drawDisplay();
+  // Call functions
+  handleButtons();
+
+  // The Wi-Fi portal and boot errors take over the screen until the restart
+  BootStage stage = bootStage;
+  if (stage >= BOOT_PORTAL) {
+    showBootMessage(stage);
+    delay(100);
+    return;
+  }
+
+  {
+    FrameProfiler::Scope timing(profiler, FrameProfiler::UPDATE_DATA);
+    updateData();
+  }
+  updateScroll();
+
+  // Pick the frame rate for what is currently animating
+  frameGovernor.setContent(scrollMessage.length() > 0 ? FrameGovernor::SCROLLING : FrameGovernor::CLOCK);
+
+  // One clock read per pass, redraw straight away when the data or the displayed second changes
+  captureTime();
+  static unsigned long lastDrawnVersion = 0;
+  if (dataVersion != lastDrawnVersion || timeNow.secondChanged) {
+    frameGovernor.requestFrame();
+    lastDrawnVersion = dataVersion;
+  }
+
+  // Update display when a frame is due
+  if (frameGovernor.frameDue(millis())) {
+    uint32_t allocationsBefore = AllocCounter::count();
+    updateFPS();
+    drawDisplay();
+    frameAllocations += AllocCounter::count() - allocationsBefore;
+    frameGovernor.frameDone(millis());
+    bootTimeline.mark(BootTimeline::FIRST_FRAME, millis());
+  }
+
+  // Report actual vs target frame rate and the frame-time histogram every 10 seconds
+  if (millis() - lastFpsReport >= 10000) {
+    lastFpsReport = millis();
+    Serial.printf("FPS: %.1f actual / %u target, %lu heap allocations while drawing, last push %luus (%luus waiting for the bus)\n",
+                  frameGovernor.actualFps(), frameGovernor.target(), (unsigned long)frameAllocations,
+                  (unsigned long)framePush.transferMicros(), (unsigned long)framePush.stallMicros());
+    if (serialTelemetry) sendTelemetry(); // before the report starts a new frame-time interval
+    frameStats.report(Serial);
+    frameAllocations = 0;
+  }
+
+  // Per-section timings, to see where the frame time goes
+  if (profileSeconds && millis() - lastProfileReport >= profileSeconds * 1000UL) {
+    lastProfileReport = millis();
+    profiler.report(Serial);
+  }
 
-  delay(1); // small delay to free up CPU cycles
+  // Sleep until the next frame (or button poll) is due
+  frameGovernor.sleep(millis());
 }
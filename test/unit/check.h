@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdio>
+
+/*
+Minimal checks for the host unit tests (nothing to fetch, builds with the simulator):
+ - CHECK() reports the failing expression and its line, then carries on with the test
+ - CHECK_EQ() also prints both values (integers)
+ - main() returns checkResult(), non-zero when any check failed, which is what ctest looks at
+*/
+static int checkFailures = 0;
+
+#define CHECK(condition)                                                            \
+  do {                                                                              \
+    if (!(condition)) {                                                             \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+      checkFailures++;                                                              \
+    }                                                                               \
+  } while (0)
+
+#define CHECK_EQ(actual, expected)                                                          \
+  do {                                                                                      \
+    long long a_ = (long long)(actual), e_ = (long long)(expected);                         \
+    if (a_ != e_) {                                                                         \
+      fprintf(stderr, "%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", __FILE__, __LINE__, \
+              #actual, #expected, a_, e_);                                                  \
+      checkFailures++;                                                                      \
+    }                                                                                       \
+  } while (0)
+
+static int checkResult(const char* name) {
+  if (checkFailures) {
+    fprintf(stderr, "%s: %d checks failed\n", name, checkFailures);
+    return 1;
+  }
+  printf("%s: ok\n", name);
+  return 0;
+}
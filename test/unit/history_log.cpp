@@ -0,0 +1,159 @@
+// HistoryLog against the simulator's in-memory LittleFS: replay, gaps, rotation and damaged files
+
+#include <vector>
+
+#include "HistoryLog.h"
+#include "check.h"
+
+static const char* const files[2] = { "/history0.log", "/history1.log" };
+static const uint32_t t0 = 1748779200;
+static const uint32_t recordSeconds = HistoryLog::recordSamples * TempHistory::sampleSeconds;
+
+static void reset() {
+  for (const char* path : files) LittleFS.remove(path);
+}
+
+// Log records of recordSamples samples each, 5 minutes apart from epoch (0 = the clock wasn't set)
+static void logRecords(uint16_t records, float value, uint32_t epoch) {
+  HistoryLog log;
+  log.begin(false);
+  TempHistory ignored;
+  log.replay(ignored); // picks the active file and sequence like a boot does
+  for (uint32_t i = 0; i < (uint32_t)records * HistoryLog::recordSamples; i++) {
+    log.append(value, epoch ? epoch + i * TempHistory::sampleSeconds : 0);
+  }
+}
+
+static uint16_t replay(TempHistory& history) {
+  HistoryLog log;
+  log.begin(false);
+  return log.replay(history);
+}
+
+static std::vector<uint8_t> readFile(const char* path) {
+  std::vector<uint8_t> data;
+  File file = LittleFS.open(path, "r");
+  if (!file) return data;
+  data.resize(file.size());
+  file.read(data.data(), data.size());
+  file.close();
+  return data;
+}
+
+static void writeFile(const char* path, const std::vector<uint8_t>& data) {
+  File file = LittleFS.open(path, "w");
+  file.write(data.data(), data.size());
+  file.close();
+}
+
+static void replaysWhatWasLogged() {
+  reset();
+  logRecords(4, 21.5f, t0);
+  TempHistory history;
+  CHECK_EQ(replay(history), 4 * HistoryLog::recordSamples);
+  history.setRange(TempHistory::LAST_2_HOURS);
+  CHECK(!history.empty());
+  CHECK(history.minimum() == 21.5f && history.maximum() == 21.5f);
+}
+
+static void pushesGapsBetweenRecords() {
+  // Two hours off between the records: the raw tier (2 hours) only sees the second one
+  reset();
+  logRecords(1, -10.0f, t0);
+  logRecords(1, 20.0f, t0 + recordSeconds + 2 * 3600);
+  TempHistory history;
+  CHECK_EQ(replay(history), 2 * HistoryLog::recordSamples);
+  history.setRange(TempHistory::LAST_2_HOURS);
+  CHECK(history.minimum() == 20.0f);
+  history.setRange(TempHistory::LAST_12_HOURS);
+  CHECK(history.minimum() == -10.0f && history.maximum() == 20.0f);
+
+  // The gap leaves empty columns between the two readings
+  const uint8_t* bars = history.graph();
+  uint8_t empty = 0;
+  for (uint8_t c = 0; c < TempHistory::columns; c++) empty += bars[c] == 0;
+  CHECK(empty > TempHistory::columns / 2);
+  CHECK(bars[TempHistory::columns - 1] == TempHistory::levels);
+}
+
+static void dropsRecordsOlderThanAWeek() {
+  reset();
+  logRecords(1, -10.0f, t0);
+  logRecords(1, 20.0f, t0 + 8 * 24 * 3600);
+  TempHistory history;
+  CHECK_EQ(replay(history), HistoryLog::recordSamples);
+  history.setRange(TempHistory::LAST_7_DAYS);
+  CHECK(history.minimum() == 20.0f);
+}
+
+static void rotatesAfterAWeekOfRecords() {
+  // Two full files and ten records into the third week: the oldest week was truncated
+  reset();
+  logRecords(2 * HistoryLog::recordsPerFile + 10, 15.0f, 0);
+  std::vector<uint8_t> newest = readFile(files[0]);
+  std::vector<uint8_t> oldest = readFile(files[1]);
+  CHECK_EQ(oldest.size(), HistoryLog::recordsPerFile * newest.size() / 10);
+
+  TempHistory history;
+  CHECK_EQ(replay(history), (HistoryLog::recordsPerFile + 10) * HistoryLog::recordSamples);
+
+  // With clock times only the last week is replayed
+  reset();
+  logRecords(2 * HistoryLog::recordsPerFile + 10, 15.0f, t0);
+  CHECK_EQ(replay(history), HistoryLog::recordsPerFile * HistoryLog::recordSamples);
+}
+
+static void appendsAfterACorruptRecordAreReplayed() {
+  reset();
+  logRecords(3, 18.0f, t0);
+  std::vector<uint8_t> data = readFile(files[0]);
+  size_t recordBytes = data.size() / 3;
+  data[recordBytes + 10] ^= 0xFF; // second record fails its CRC
+  writeFile(files[0], data);
+
+  TempHistory history;
+  CHECK_EQ(replay(history), HistoryLog::recordSamples);
+
+  // The next record starts the other file instead of landing behind the damage
+  logRecords(1, 18.0f, t0 + 3 * recordSeconds);
+  CHECK_EQ(readFile(files[1]).size(), recordBytes);
+  TempHistory after;
+  CHECK_EQ(replay(after), 2 * HistoryLog::recordSamples);
+}
+
+static void appendsAfterATruncatedRecordAreReplayed() {
+  // Power lost in the middle of an append
+  reset();
+  logRecords(2, 18.0f, t0);
+  std::vector<uint8_t> data = readFile(files[0]);
+  data.resize(data.size() + data.size() / 4, 0x5A);
+  writeFile(files[0], data);
+
+  TempHistory history;
+  CHECK_EQ(replay(history), 2 * HistoryLog::recordSamples);
+
+  logRecords(1, 18.0f, t0 + 2 * recordSeconds);
+  TempHistory after;
+  CHECK_EQ(replay(after), 3 * HistoryLog::recordSamples);
+}
+
+static void skipsTheOtherUnitSystem() {
+  reset();
+  logRecords(2, 18.0f, t0);
+  HistoryLog imperial;
+  imperial.begin(true);
+  TempHistory history;
+  CHECK_EQ(imperial.replay(history), 0);
+  CHECK(history.empty());
+}
+
+int main() {
+  replaysWhatWasLogged();
+  pushesGapsBetweenRecords();
+  dropsRecordsOlderThanAWeek();
+  rotatesAfterAWeekOfRecords();
+  appendsAfterACorruptRecordAreReplayed();
+  appendsAfterATruncatedRecordAreReplayed();
+  skipsTheOtherUnitSystem();
+  return checkResult("history_log");
+}
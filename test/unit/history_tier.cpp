@@ -0,0 +1,124 @@
+// HistoryTier against a model that keeps every bucket: rollover into the next tier and ring wraparound
+
+#include <vector>
+
+#include "HistoryTier.h"
+#include "check.h"
+
+static uint32_t state = 54321;
+static uint32_t nextRandom() {
+  state = state * 1103515245u + 12345u;
+  return state >> 16;
+}
+
+static TempBucket randomInput(bool gaps) {
+  if (gaps && nextRandom() % 8 == 0) return noTemp;
+  int16_t avg = (int16_t)(nextRandom() % 4001) - 2000;
+  return { (int16_t)(avg - nextRandom() % 50), avg, (int16_t)(avg + nextRandom() % 50) };
+}
+
+static bool same(const TempBucket& a, const TempBucket& b) {
+  return a.low == b.low && a.avg == b.avg && a.high == b.high;
+}
+
+// Every completed bucket and the inputs of the pending one
+struct Model {
+  std::vector<TempBucket> complete;
+  std::vector<TempBucket> inputs;
+
+  static TempBucket consolidate(const std::vector<TempBucket>& in) {
+    TempBucket bucket = { INT16_MAX, 0, INT16_MIN };
+    int32_t sum = 0;
+    int count = 0;
+    for (const TempBucket& b : in) {
+      bucket.low = min(bucket.low, b.low);
+      bucket.high = max(bucket.high, b.high);
+      if (hasTemp(b)) {
+        sum += b.avg;
+        count++;
+      }
+    }
+    if (count == 0) return noTemp;
+    bucket.avg = (int16_t)lroundf((float)sum / count);
+    return bucket;
+  }
+
+  // The newest Capacity buckets, the pending one standing in for the oldest
+  std::vector<TempBucket> view(uint16_t capacity) const {
+    size_t shown = min<size_t>(complete.size(), inputs.empty() ? capacity : capacity - 1);
+    std::vector<TempBucket> out(complete.end() - shown, complete.end());
+    if (!inputs.empty()) out.push_back(consolidate(inputs));
+    return out;
+  }
+};
+
+template <uint16_t Capacity, uint8_t Samples>
+static void matchesModel(uint32_t count, bool gaps) {
+  HistoryTier<Capacity, Samples> tier;
+  Model model;
+  CHECK(tier.empty());
+  CHECK(!tier.hasTemps());
+
+  for (uint32_t i = 0; i < count; i++) {
+    TempBucket in = randomInput(gaps);
+    TempBucket completed;
+    bool done = tier.add(in, completed);
+
+    model.inputs.push_back(in);
+    bool expectDone = model.inputs.size() == Samples;
+    CHECK(done == expectDone);
+    if (expectDone) {
+      TempBucket expected = Model::consolidate(model.inputs);
+      CHECK(done && same(completed, expected));
+      model.complete.push_back(expected);
+      model.inputs.clear();
+    }
+
+    std::vector<TempBucket> view = model.view(Capacity);
+    int16_t low = INT16_MAX, high = INT16_MIN;
+    bool ok = tier.size() == view.size();
+    for (uint16_t j = 0; ok && j < view.size(); j++) {
+      ok = same(tier[j], view[j]);
+      low = min(low, view[j].low);
+      high = max(high, view[j].high);
+    }
+    if (!ok || tier.hasTemps() != (low <= high) || (low <= high && (tier.low() != low || tier.high() != high))) {
+      fprintf(stderr, "HistoryTier<%u, %u> differs from the model after input %u\n", Capacity, Samples, i);
+      CHECK_EQ(tier.size(), view.size());
+      checkFailures++;
+      return;
+    }
+  }
+}
+
+static void bucketOfGapsIsAGap() {
+  HistoryTier<4, 3> tier;
+  TempBucket completed;
+  tier.add(noTemp, completed);
+  CHECK(!tier.empty() && !tier.hasTemps());
+  tier.add(noTemp, completed);
+  CHECK(tier.add(noTemp, completed));
+  CHECK(same(completed, noTemp));
+
+  // One reading makes the bucket (and the view) hold a temperature again
+  TempBucket reading = { 100, 150, 200 };
+  tier.add(noTemp, completed);
+  tier.add(reading, completed);
+  CHECK(tier.hasTemps());
+  CHECK_EQ(tier.low(), 100);
+  CHECK_EQ(tier.high(), 200);
+  CHECK(tier.add(noTemp, completed));
+  CHECK(same(completed, reading));
+}
+
+int main() {
+  matchesModel<2, 1>(50, false);
+  matchesModel<24, 1>(200, false);   // raw samples
+  matchesModel<24, 6>(1000, false);  // 30 minute buckets
+  matchesModel<56, 6>(2000, false);  // 3 hour buckets
+  matchesModel<5, 3>(200000, false); // the ring wraps many times over
+  matchesModel<24, 6>(2000, true);
+  matchesModel<7, 2>(5000, true);
+  bucketOfGapsIsAGap();
+  return checkResult("history_tier");
+}
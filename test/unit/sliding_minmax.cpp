@@ -0,0 +1,70 @@
+// SlidingMinMax against a brute-force scan of the last Window values
+
+#include <vector>
+
+#include "SlidingMinMax.h"
+#include "check.h"
+
+// Small deterministic generator, the same sequence on every run
+static uint32_t state = 12345;
+static int16_t nextValue(int16_t spread) {
+  state = state * 1103515245u + 12345u;
+  return (int16_t)((state >> 16) % (2 * spread + 1)) - spread;
+}
+
+// Push count values (or ranges) and compare with the window scanned from the full history
+template <uint16_t Window>
+static void matchesBruteForce(uint32_t count, int16_t spread, bool ranges) {
+  SlidingMinMax<int16_t, Window> window;
+  std::vector<int16_t> lows, highs;
+  CHECK(window.empty());
+
+  for (uint32_t i = 0; i < count; i++) {
+    int16_t low = nextValue(spread);
+    int16_t high = ranges ? low + (int16_t)(nextValue(spread) & 0x0F) : low;
+    if (ranges) window.push(low, high);
+    else window.push(low);
+    lows.push_back(low);
+    highs.push_back(high);
+
+    int16_t expectedMin = INT16_MAX, expectedMax = INT16_MIN;
+    size_t first = lows.size() > Window ? lows.size() - Window : 0;
+    for (size_t j = first; j < lows.size(); j++) {
+      expectedMin = min(expectedMin, lows[j]);
+      expectedMax = max(expectedMax, highs[j]);
+    }
+    if (window.minimum() != expectedMin || window.maximum() != expectedMax) {
+      CHECK_EQ(window.minimum(), expectedMin);
+      CHECK_EQ(window.maximum(), expectedMax);
+      return; // one report per sequence
+    }
+  }
+}
+
+static void monotonicRuns() {
+  // Rising values keep every entry in the min deque until it ages out, falling ones in the max deque
+  SlidingMinMax<int16_t, 4> window;
+  for (int16_t v = 0; v < 10; v++) window.push(v);
+  CHECK_EQ(window.minimum(), 6);
+  CHECK_EQ(window.maximum(), 9);
+  for (int16_t v = 10; v > 0; v--) window.push(v);
+  CHECK_EQ(window.minimum(), 1);
+  CHECK_EQ(window.maximum(), 4);
+
+  window.clear();
+  CHECK(window.empty());
+  window.push(-5);
+  CHECK_EQ(window.minimum(), -5);
+  CHECK_EQ(window.maximum(), -5);
+}
+
+int main() {
+  matchesBruteForce<1>(500, 100, false);
+  matchesBruteForce<5>(2000, 100, false);
+  matchesBruteForce<23>(5000, 3, false); // many repeated values
+  matchesBruteForce<23>(5000, 1000, true);
+  matchesBruteForce<55>(5000, 1000, true);
+  matchesBruteForce<7>(70000, 500, false); // sequence numbers wrap past 65535
+  monotonicRuns();
+  return checkResult("sliding_minmax");
+}
@@ -0,0 +1,168 @@
+// Telemetry frames: encode/parse round trip, bad CRCs, split frames and resync after damage or stray sync bytes
+
+#include <cstring>
+#include <vector>
+
+#include "Telemetry.h"
+#include "check.h"
+
+static Telemetry::Record sample(uint32_t sequence) {
+  Telemetry::Record record;
+  record.sequence = sequence;
+  record.uptimeMs = 0xDEADBEEF;
+  record.frameAverageUs = 16667;
+  record.frameMinUs = 1200;
+  record.frameMaxUs = 250000;
+  record.frames = 300;
+  record.heapFree = 180000;
+  record.heapLargestBlock = 110000;
+  record.fetchConnectMs = 0;
+  record.fetchRequestMs = 165;
+  record.rssi = -67;
+  record.weatherRetries = 2;
+  record.timeSyncRetries = 255;
+  return record;
+}
+
+static bool same(const Telemetry::Record& a, const Telemetry::Record& b) {
+  return a.sequence == b.sequence && a.uptimeMs == b.uptimeMs && a.frameAverageUs == b.frameAverageUs &&
+         a.frameMinUs == b.frameMinUs && a.frameMaxUs == b.frameMaxUs && a.frames == b.frames &&
+         a.heapFree == b.heapFree && a.heapLargestBlock == b.heapLargestBlock &&
+         a.fetchConnectMs == b.fetchConnectMs && a.fetchRequestMs == b.fetchRequestMs && a.rssi == b.rssi &&
+         a.weatherRetries == b.weatherRetries && a.timeSyncRetries == b.timeSyncRetries;
+}
+
+static std::vector<uint8_t> frame(uint32_t sequence) {
+  std::vector<uint8_t> out(Telemetry::frameBytes);
+  CHECK_EQ(Telemetry::encode(sample(sequence), out.data()), Telemetry::frameBytes);
+  return out;
+}
+
+static void append(std::vector<uint8_t>& stream, const std::vector<uint8_t>& bytes) {
+  stream.insert(stream.end(), bytes.begin(), bytes.end());
+}
+
+static void appendText(std::vector<uint8_t>& stream, const char* text) {
+  stream.insert(stream.end(), text, text + strlen(text));
+}
+
+// Feed the stream in chunks of chunk bytes (a serial read at a time), collect the sequence numbers
+static std::vector<uint32_t> parse(Telemetry::Parser& parser, const std::vector<uint8_t>& stream, size_t chunk) {
+  std::vector<uint32_t> sequences;
+  for (size_t start = 0; start < stream.size(); start += chunk) {
+    for (size_t i = start; i < stream.size() && i < start + chunk; i++) {
+      Telemetry::Record record;
+      if (!parser.push(stream[i], record)) continue;
+      CHECK(same(record, sample(record.sequence)));
+      sequences.push_back(record.sequence);
+    }
+  }
+  return sequences;
+}
+
+static void roundTrip() {
+  std::vector<uint8_t> bytes = frame(7);
+  CHECK(bytes[0] == Telemetry::sync0 && bytes[1] == Telemetry::sync1);
+  CHECK(bytes[2] == Telemetry::version && bytes[3] == Telemetry::recordBytes);
+
+  // zlib.crc32(b"123456789") == 0xCBF43926
+  CHECK(Telemetry::crc32((const uint8_t*)"123456789", 9) == 0xCBF43926);
+
+  Telemetry::Parser parser;
+  std::vector<uint8_t> stream;
+  appendText(stream, "FPS: 30.0 (target 30)\n");
+  append(stream, frame(1));
+  appendText(stream, "Boot: first frame 0ms\n");
+  append(stream, frame(2));
+  std::vector<uint32_t> got = parse(parser, stream, stream.size());
+  CHECK(got == std::vector<uint32_t>({ 1, 2 }));
+  CHECK_EQ(parser.crcErrors(), 0);
+}
+
+static void splitFrames() {
+  // Frames cut across reads at every possible point, back to back with no text between
+  std::vector<uint8_t> stream;
+  for (uint32_t seq = 0; seq < 4; seq++) append(stream, frame(seq));
+  for (size_t chunk = 1; chunk <= Telemetry::frameBytes + 1; chunk++) {
+    Telemetry::Parser parser;
+    CHECK(parse(parser, stream, chunk) == std::vector<uint32_t>({ 0, 1, 2, 3 }));
+  }
+}
+
+static void badCrcIsDropped() {
+  std::vector<uint8_t> bad = frame(2);
+  bad[Telemetry::headerBytes + 5] ^= 0x01; // one payload bit
+  std::vector<uint8_t> stream;
+  append(stream, frame(1));
+  append(stream, bad);
+  append(stream, frame(3));
+
+  Telemetry::Parser parser;
+  CHECK(parse(parser, stream, 16) == std::vector<uint32_t>({ 1, 3 }));
+  CHECK_EQ(parser.crcErrors(), 1);
+}
+
+static void resyncsAfterACorruptLength() {
+  // A damaged length claims the frames behind it, they are found again once its CRC fails
+  std::vector<uint8_t> bad = frame(1);
+  bad[3] = 200;
+  std::vector<uint8_t> stream;
+  append(stream, bad);
+  for (uint32_t seq = 2; seq < 8; seq++) append(stream, frame(seq));
+
+  Telemetry::Parser parser;
+  CHECK(parse(parser, stream, 64) == std::vector<uint32_t>({ 2, 3, 4, 5, 6, 7 }));
+  CHECK_EQ(parser.crcErrors(), 1);
+}
+
+static void syncBytesInText() {
+  // Log lines can carry the sync bytes: a UTF-8 SSID ("å" is C3 A5) and a full false start
+  std::vector<uint8_t> stream;
+  appendText(stream, "WiFi connected: Sm\xC3\xA5land\n");
+  append(stream, frame(1));
+  appendText(stream, "SSID: \xA5\xA5\x5A\x01\x2B garbage after a false header\n");
+  append(stream, frame(2));
+  appendText(stream, "\xA5");
+  append(stream, frame(3));
+  appendText(stream, "tail \xA5\x5A");
+  append(stream, frame(4)); // read as the false start's payload until frame 5 makes its CRC fail
+  append(stream, frame(5));
+
+  for (size_t chunk : { (size_t)1, (size_t)7, stream.size() }) {
+    Telemetry::Parser parser;
+    CHECK(parse(parser, stream, chunk) == std::vector<uint32_t>({ 1, 2, 3, 4, 5 }));
+  }
+}
+
+static void versionsAndLengths() {
+  // A newer version with extra fields still decodes the known ones
+  std::vector<uint8_t> longer = frame(5);
+  longer.resize(Telemetry::headerBytes + Telemetry::recordBytes);
+  longer[2] = 2;
+  longer[3] = Telemetry::recordBytes + 3;
+  longer.insert(longer.end(), { 0x11, 0x22, 0x33 });
+  uint32_t crc = Telemetry::crc32(longer.data() + 2, longer.size() - 2);
+  for (int i = 0; i < 4; i++) longer.push_back((uint8_t)(crc >> (8 * i)));
+
+  // A valid frame that is too short for version 1 is not a record
+  std::vector<uint8_t> shorter = { Telemetry::sync0, Telemetry::sync1, 1, 2, 0x01, 0x02 };
+  crc = Telemetry::crc32(shorter.data() + 2, shorter.size() - 2);
+  for (int i = 0; i < 4; i++) shorter.push_back((uint8_t)(crc >> (8 * i)));
+
+  std::vector<uint8_t> stream;
+  append(stream, longer);
+  append(stream, shorter);
+  append(stream, frame(6));
+  Telemetry::Parser parser;
+  CHECK(parse(parser, stream, 1) == std::vector<uint32_t>({ 5, 6 }));
+}
+
+int main() {
+  roundTrip();
+  splitFrames();
+  badCrcIsDropped();
+  resyncsAfterACorruptLength();
+  syncBytesInText();
+  versionsAndLengths();
+  return checkResult("telemetry");
+}
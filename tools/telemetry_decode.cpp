@@ -0,0 +1,39 @@
+/*
+Host decoder for the binary telemetry frames (see include/Telemetry.h):
+  g++ -std=c++11 -Iinclude tools/telemetry_decode.cpp src/Telemetry.cpp -o telemetry_decode
+  stty -F /dev/ttyACM0 115200 raw && ./telemetry_decode /dev/ttyACM0 > telemetry.csv
+Reads a serial port, a capture file or stdin (no argument), skips the text log around the frames
+and prints one CSV line per valid frame, flushed as it arrives so it can be graphed live.
+*/
+
+#include <cstdio>
+
+#include "Telemetry.h"
+
+int main(int argc, char** argv) {
+  FILE* in = argc > 1 ? fopen(argv[1], "rb") : stdin;
+  if (!in) {
+    perror(argv[1]);
+    return 1;
+  }
+
+  printf("sequence,uptime_ms,frame_avg_us,frame_min_us,frame_max_us,frames,heap_free,heap_largest_block,"
+         "fetch_connect_ms,fetch_request_ms,rssi_dbm,weather_retries,time_sync_retries\n");
+
+  Telemetry::Parser parser;
+  Telemetry::Record r;
+  unsigned long decoded = 0;
+  int c;
+  while ((c = fgetc(in)) != EOF) {
+    if (!parser.push((uint8_t)c, r)) continue;
+    printf("%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%d,%u,%u\n", (unsigned long)r.sequence, (unsigned long)r.uptimeMs,
+           (unsigned long)r.frameAverageUs, (unsigned long)r.frameMinUs, (unsigned long)r.frameMaxUs, (unsigned long)r.frames,
+           (unsigned long)r.heapFree, (unsigned long)r.heapLargestBlock, (unsigned long)r.fetchConnectMs,
+           (unsigned long)r.fetchRequestMs, r.rssi, r.weatherRetries, r.timeSyncRetries);
+    fflush(stdout);
+    decoded++;
+  }
+
+  fprintf(stderr, "%lu frames decoded, %lu dropped for a bad CRC\n", decoded, (unsigned long)parser.crcErrors());
+  return 0;
+}